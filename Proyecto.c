@@ -1,19 +1,40 @@
 //biosim - simulador de propagacion y contencion de epidemias
 //proyecto final de algoritmos
 //compilar: gcc Proyecto.c sqlite3.c -o BioSim -lm
+//paralelo (opcional): gcc -fopenmp Proyecto.c sqlite3.c -o BioSim -lm
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <math.h>
+#include <time.h>
 #include "sqlite3.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 //constantes del sistema
 #define NUM_TERRITORIOS 20      //numero de paises/territorios
 #define SIN_CONEXION 0.0        //valor para indicar que no hay conexion
+#define MAX_CONEXIONES (NUM_TERRITORIOS * (NUM_TERRITORIOS - 1) / 2)  //aristas posibles
 #define MAX_INDIVIDUOS 150      //maximo de personas por territorio
 #define NUM_CEPAS 50            //numero de variantes del virus
-#define HASH_SIZE 2053          //tamanio de la tabla hash (numero primo)
-#define ALPHABET_SIZE 26        //letras del alfabeto para el trie
+#define HASH_CAPACIDAD_INICIAL 1024  //ranuras iniciales de la tabla hash (potencia de 2)
+#define HASH_CARGA_NUM 7        //carga maxima de la tabla hash = 7/8
+#define HASH_CARGA_DEN 8
+#define HASH_VACIO -1           //id que marca una ranura libre
+#define DIRECTORIO_CAPACIDAD_INICIAL 1024  //entradas iniciales del directorio por id
+#define CONSULTAS_PRUEBA_HASH 200000       //consultas por carga en la prueba de rendimiento
+#define LOTE_PRUEBA_HASH 64                //consultas por medicion (percentiles por lote)
+#define MAX_POBLACION_PRUEBA_HASH 20000000 //poblacion sintetica maxima de la prueba
+#define FRANJAS_CONCURRENTE 256            //candados de escritura del hash concurrente (potencia de 2)
+#define MAX_HILOS_CONCURRENTE 64           //hilos que pueden leer el hash concurrente
+#define LARGO_CLAVE_TRIE 64     //bytes maximos de una clave del trie de cepas
+#define MIN_CEPAS_CLUSTER 2     //cepas minimas para formar un cluster
+#define UMBRAL_TOPK_PARALELO 65536  //n minimo para seleccion top-k por bloques
+#define NUM_SIMULACIONES_MC 100 //simulaciones monte carlo por evaluacion celf
+#define DISTANCIA_INFINITA 999999.0 //distancia entre territorios sin ruta
+#define NUM_TAMANIOS_COLA 4     //clases de tamanio para elegir backend de cola
 //estados posibles de un individuo
 #define ESTADO_SANO 0
 #define ESTADO_INFECTADO 1
@@ -34,7 +55,8 @@ typedef struct Individuo{
     char Nombre[50];            //nombre de la persona
     int Territorio_ID;          //territorio donde vive
     float Riesgo_inicial;       //nivel de riesgo base
-    int Grado_inicial;          //numero de contactos
+    int Grado_inicial;          //numero de contactos objetivo (aleatorio)
+    int Grado;                  //numero real de contactos (se mantiene al agregar/eliminar)
     
     int Infectado;              //1 si esta infectado, 0 si no
     int t_infeccion;            //dia en que se infecto
@@ -70,32 +92,274 @@ typedef struct MinHeap{
     int size;                   //elementos actuales
 } MinHeap;
 
-//nodo para la tabla hash de individuos
-typedef struct NodoHash{
-    int ID;                         //id del individuo
+//backends disponibles para la cola de prioridad de dijkstra y prim
+typedef enum TipoCola{
+    COLA_BINARIA,               //minheap binario original
+    COLA_CUATERNARIA,           //heap 4-ario (menos niveles, mejor cache)
+    COLA_EMPAREJAMIENTO,        //pairing heap (disminuir clave barato)
+    COLA_RADIX,                 //radix heap sobre los bits del float (solo llaves monotonas)
+    NUM_TIPOS_COLA
+} TipoCola;
+
+//nodo del pairing heap (indexado por vertice)
+typedef struct NodoPareo{
+    int hijo;                   //primer hijo
+    int hermano;                //siguiente hermano
+    int anterior;               //hermano anterior o padre si es el primer hijo
+    float prioridad;            //prioridad actual
+} NodoPareo;
+
+//entrada de una cubeta del radix heap
+typedef struct EntradaRadix{
+    int vertice;                //indice del vertice
+    unsigned int llave;         //bits del float de la prioridad
+} EntradaRadix;
+
+//cola de prioridad con backend intercambiable y insercion perezosa
+typedef struct ColaPrioridad{
+    TipoCola tipo;              //backend en uso
+    int capacidad;              //numero de vertices
+    int size;                   //vertices actualmente en la cola
+    int *estado;                //0 = ausente, 1 = en cola, 2 = extraido
+    MinHeap *binario;           //backend binario
+    NodoHeap *nodos;            //arreglo del heap 4-ario
+    int *posiciones;            //posicion de cada vertice en el heap 4-ario
+    NodoPareo *pareo;           //nodos del pairing heap
+    int *pila;                  //auxiliar para fusionar hijos al extraer
+    int raiz;                   //raiz del pairing heap
+    EntradaRadix *cubetas[33];  //cubetas del radix heap (por bit mas alto distinto)
+    int cubeta_size[33];        //elementos por cubeta
+    int cubeta_cap[33];         //capacidad por cubeta
+    unsigned int ultima;        //ultima llave extraida del radix heap
+    unsigned int *llave_actual; //llave vigente por vertice (descarta duplicados)
+} ColaPrioridad;
+
+//ruta simple entre territorios para las k rutas mas cortas
+typedef struct RutaK{
+    int nodos[NUM_TERRITORIOS]; //territorios en orden
+    int longitud;               //numero de territorios en la ruta
+    float costo;                //suma de 1/proximidad
+} RutaK;
+
+//espacio de trabajo reutilizable para yen (uno por hilo)
+typedef struct EspacioYen{
+    float distancia[NUM_TERRITORIOS];
+    int padre[NUM_TERRITORIOS];
+    int vertice_bloqueado[NUM_TERRITORIOS];
+    int arista_bloqueada[2 * MAX_CONEXIONES]; //indexado por arista csr
+    ColaPrioridad *cola;        //cola de prioridad reutilizada entre busquedas
+    RutaK *candidatos;          //rutas candidatas ordenadas por costo
+    int num_candidatos;
+    int cap_candidatos;
+} EspacioYen;
+
+//consulta (origen, destino, k) para el modo por lotes
+typedef struct ConsultaKRutas{
+    int origen;
+    int destino;
+    int k;
+    RutaK *rutas;               //arreglo de k rutas (lo llena el lote)
+    int encontradas;            //rutas encontradas (<= k)
+} ConsultaKRutas;
+
+//espacio de trabajo reutilizable para consultas punto a punto (uno por hilo)
+typedef struct EspacioRuta{
+    float distancia[2][NUM_TERRITORIOS];    //0 = desde el origen, 1 = desde el destino
+    int padre[2][NUM_TERRITORIOS];
+    ColaPrioridad *cola[2];                 //una cola por sentido de busqueda
+} EspacioRuta;
+
+//consulta origen -> destino para el modo por lotes
+typedef struct ConsultaRuta{
+    int origen;
+    int destino;
+    int ruta[NUM_TERRITORIOS];  //territorios en orden (lo llena el lote)
+    int longitud;               //0 si no hay ruta
+    float costo;                //suma de 1/proximidad
+} ConsultaRuta;
+
+//red de contactos en formato csr (vista de solo lectura de las listas de contactos)
+typedef struct RedContactos{
+    int n;                      //numero de individuos (ids 0..n-1)
+    int *inicio;                //inicio de los contactos de cada id
+    int *vecino;                //ids de contactos concatenados
+    float *prob;                //probabilidad de contagio de cada contacto
+    Individuo **por_id;         //individuo por id
+} RedContactos;
+
+//componentes conexas de la red de contactos (ids compactos 0..k-1)
+typedef struct ComponentesRed{
+    int n;                      //numero de individuos (ids 0..n-1)
+    int *componente;            //componente de cada id
+    int *tamanio;               //individuos en cada componente
+    int num_componentes;        //total de componentes
+} ComponentesRed;
+
+//espacio de trabajo de brandes por hilo
+typedef struct EspacioBrandes{
+    float *distancia;           //distancia desde la fuente
+    double *sigma;              //numero de caminos minimos
+    double *delta;              //dependencia acumulada
+    int *orden;                 //vertices en orden de extraccion
+    ColaPrioridad *cola;        //cola para la version ponderada
+    double *centralidad;        //acumulador local del hilo
+} EspacioBrandes;
+
+//ranura de la tabla hash de individuos (clave y valor en linea, 16 bytes)
+typedef struct RanuraHash{
+    int ID;                         //id del individuo (HASH_VACIO si esta libre)
+    int distancia;                  //ranuras desde su posicion ideal (robin hood)
     Individuo *individuo;           //puntero al individuo
-    struct NodoHash *siguiente;     //siguiente nodo (para colisiones)
-} NodoHash;
+} RanuraHash;
 
-//tabla hash para busqueda de individuos en o(1)
+//tabla hash para busqueda de individuos en o(1) con direccionamiento abierto
 typedef struct HashTable{
-    NodoHash *tabla[HASH_SIZE];     //arreglo de punteros a nodos
+    RanuraHash *ranuras;            //arreglo contiguo de ranuras
+    int capacidad;                  //numero de ranuras (potencia de 2)
     int num_elementos;              //cantidad de elementos almacenados
 } HashTable;
 
-//nodo del trie para clustering de cepas
+//nodo de la tabla encadenada de referencia (solo para la prueba de rendimiento)
+typedef struct NodoEncadenado{
+    int ID;                         //id del individuo
+    Individuo *individuo;           //puntero al individuo
+    struct NodoEncadenado *siguiente;  //siguiente nodo de la cubeta
+} NodoEncadenado;
+
+//tabla encadenada de referencia (solo para la prueba de rendimiento)
+typedef struct TablaEncadenada{
+    NodoEncadenado **cubetas;       //listas por cubeta
+    int num_cubetas;                //potencia de 2
+} TablaEncadenada;
+
+//nodo del hash concurrente (inmutable salvo el valor y el enlace, que se escriben atomicamente)
+typedef struct NodoHashConcurrente{
+    int ID;                         //id del individuo
+    Individuo *individuo;           //puntero al individuo
+    struct NodoHashConcurrente *siguiente;  //siguiente nodo de la cubeta
+} NodoHashConcurrente;
+
+//arreglo de cubetas del hash concurrente (se reemplaza completo al crecer)
+typedef struct TablaHashConcurrente{
+    NodoHashConcurrente **cubetas;  //cabezas de las cadenas
+    int num_cubetas;                //potencia de 2 >= FRANJAS_CONCURRENTE
+} TablaHashConcurrente;
+
+//epoca anunciada por un hilo lector (una linea de cache por hilo)
+typedef struct RanuraEpoca{
+    unsigned long estado;           //(epoca << 1) | 1 si esta leyendo, 0 si no
+    char relleno[64 - sizeof(unsigned long)];
+} RanuraEpoca;
+
+//bloque desenlazado que espera a que ningun lector pueda verlo
+typedef struct RetiradoEpoca{
+    void *bloque;                   //memoria a liberar
+    unsigned long epoca;            //epoca global al retirarlo
+    struct RetiradoEpoca *siguiente;
+} RetiradoEpoca;
+
+//hash de individuos para consultas desde varios hilos mientras la simulacion muta
+typedef struct HashConcurrente{
+    TablaHashConcurrente *tabla;    //tabla vigente (publicada atomicamente)
+    int num_elementos;              //elementos almacenados
+    int franjas[FRANJAS_CONCURRENTE];  //candados de escritura por franja de cubetas
+    unsigned long epoca_global;     //epoca vigente de reclamacion
+    RanuraEpoca epocas[MAX_HILOS_CONCURRENTE];  //epoca anunciada por cada hilo
+    RetiradoEpoca *retirados;       //bloques pendientes de liberar
+    int num_retirados;              //cantidad pendiente
+    int candado_retirados;          //protege la lista de retirados
+} HashConcurrente;
+
+//nombre normalizado de un individuo (para ordenar al construir el indice de nombres)
+typedef struct ParNombre{
+    const char *clave;              //nombre en minusculas
+    int id;                         //id del individuo
+} ParNombre;
+
+//nodo del trie compacto de prefijos (hijos contiguos y ordenados por byte)
+typedef struct NodoPrefijo{
+    int lo;                         //primer nombre distinto con este prefijo
+    int hi;                         //uno despues del ultimo
+    int primer_hijo;                //indice del primer hijo en el arreglo de nodos
+    int num_hijos;                  //hijos contiguos
+    unsigned char etiqueta;         //byte que lleva a este nodo
+} NodoPrefijo;
+
+//indice de nombres de individuos: hash para exactos y trie compacto para prefijos
+typedef struct IndiceNombres{
+    int num_nombres;                //nombres distintos
+    int num_ids;                    //individuos indexados
+    char **nombres;                 //nombres distintos normalizados en orden lexicografico
+    char *texto;                    //bloque con los nombres internados
+    int *inicio;                    //ids del nombre k en ids[inicio[k]..inicio[k+1])
+    int *ids;                       //ids agrupados por nombre (y por id dentro de cada nombre)
+    int *ranuras;                   //hash abierto: indice del nombre o -1
+    int capacidad;                  //ranuras del hash (potencia de 2)
+    NodoPrefijo *nodos;             //trie de prefijos (nodo 0 = raiz)
+    int num_nodos;                  //nodos del trie
+} IndiceNombres;
+
+//estructuras comparadas en la prueba de rendimiento (ids densos 0..n-1)
+typedef struct EstructurasPrueba{
+    TablaEncadenada *encadenada;    //hash encadenada
+    HashTable *abierta;             //hash robin hood
+    Individuo **directa;            //directorio indexado por id
+    int *lineal_ids;                //ids para la busqueda lineal
+    int n;                          //poblacion
+} EstructurasPrueba;
+
+//nodo del trie radix de cepas (arista comprimida, hijos enlazados por indice)
 typedef struct NodoTrie{
-    struct NodoTrie *hijos[ALPHABET_SIZE];  //26 hijos (a-z)
-    int es_final;                   //1 si termina una palabra aqui
-    int cepa_id;                    //id de la cepa si es final
+    int etiqueta;                   //inicio de la etiqueta de la arista en el texto del trie
+    int largo;                      //bytes de la etiqueta
+    int primer_hijo;                //primer hijo (-1 si no tiene), hijos ordenados por byte
+    int hermano;                    //siguiente hermano (-1 si es el ultimo)
+    int cepa_id;                    //id de la cepa si termina una palabra aqui (-1 si no)
+    unsigned char primer_byte;      //primer byte de la etiqueta para elegir hijo sin ir al texto
 } NodoTrie;
 
 //estructura principal del trie
 typedef struct Trie{
-    NodoTrie *raiz;                 //nodo raiz
+    NodoTrie *nodos;                //nodos en arreglo contiguo (0 = raiz)
+    int num_nodos;                  //nodos usados
+    int capacidad_nodos;            //nodos reservados
+    char *texto;                    //claves normalizadas a las que apuntan las etiquetas
+    int largo_texto;                //bytes usados del texto
+    int capacidad_texto;            //bytes reservados del texto
     int num_palabras;               //cantidad de palabras insertadas
+    int *cantidad_subarbol;         //cepas en el subarbol de cada nodo
+    double *suma_contagio;          //suma de tasas de contagio del subarbol
+    double *suma_mortalidad;        //suma de tasas de mortalidad del subarbol
+    int agregados_listos;           //1 si los agregados corresponden al trie actual
 } Trie;
 
+//cepa encontrada por la busqueda aproximada
+typedef struct CoincidenciaCepa{
+    int cepa_id;                    //id asociado a la palabra
+    int distancia;                  //distancia de edicion a la consulta
+    int orden;                      //posicion lexicografica (desempate)
+} CoincidenciaCepa;
+
+//estado de la busqueda aproximada: una fila de levenshtein por byte de profundidad
+typedef struct BusquedaDifusa{
+    const char *clave;              //consulta normalizada
+    int m;                          //largo de la consulta
+    int k;                          //distancia maxima aceptada
+    int filas[LARGO_CLAVE_TRIE + 1][LARGO_CLAVE_TRIE + 1];
+    CoincidenciaCepa *resultados;   //coincidencias encontradas
+    int num_resultados;
+    int capacidad;
+    long nodos_visitados;           //nodos alcanzados sin poda
+} BusquedaDifusa;
+
+//cluster de cepas: prefijo terminado en separador compartido por varias cepas
+typedef struct ClusterCepas{
+    int nodo;                       //nodo del trie cuyo subarbol forma el cluster
+    int representante;              //cepa cuyo nombre da el prefijo a mostrar
+    int largo_prefijo;              //bytes del prefijo (incluye el separador)
+    int nivel;                      //profundidad en la jerarquia de clusters
+} ClusterCepas;
+
 //estructura para los 10 pacientes infectados iniciales
 typedef struct Semilla{
     int individuo_id;               //id del paciente cero
@@ -147,15 +411,42 @@ typedef struct Mapa{
     int num_territorios;            //cantidad de territorios
     int num_conexiones;             //cantidad de conexiones
     
+    ConexionTerritorio conexiones[MAX_CONEXIONES];  //lista de aristas
+    int csr_inicio[NUM_TERRITORIOS + 1];    //inicio de los vecinos de cada territorio
+    int csr_vecino[2 * MAX_CONEXIONES];     //vecinos concatenados por territorio
+    float csr_peso[2 * MAX_CONEXIONES];     //proximidad de cada arista del csr
+    int csr_valido;                 //0 si el csr debe reconstruirse
+    
+    unsigned char mst_arista[NUM_TERRITORIOS][NUM_TERRITORIOS];  //aristas del bosque minimo dinamico
+    int mst_valido;                 //0 si el bosque debe reconstruirse con kruskal
+    
     Cepa cepas[NUM_CEPAS];          //arreglo de cepas
     int num_cepas;                  //cantidad de cepas
     
     HashTable *hash_individuos;     //hash para buscar individuos
+    Individuo **directorio;         //individuo por id (ids densos, un acceso)
+    int capacidad_directorio;       //entradas reservadas en el directorio
+    HashTable *ids_dispersos;       //individuos con ids fuera del rango denso
+    IndiceNombres *indice_nombres;  //busqueda de individuos por nombre y prefijo
     HashTableCepas *hash_cepas;     //hash para buscar cepas
     Trie *trie_cepas;               //trie para clustering de cepas
     
     Semilla semillas[10];           //10 semillas iniciales
     int num_semillas;               //cantidad de semillas
+    
+    double riesgo_total;            //acumulador de riesgo (se actualiza por deltas)
+    double riesgo_territorio[NUM_TERRITORIOS];  //riesgo acumulado por territorio
+    
+    float distancias[NUM_TERRITORIOS][NUM_TERRITORIOS];  //cache de distancias minimas
+    int siguiente[NUM_TERRITORIOS][NUM_TERRITORIOS];     //siguiente salto en la ruta minima
+    int distancias_validas;         //0 si la cache debe recalcularse
+    
+    int infectados_territorio[NUM_TERRITORIOS];  //infectados activos por territorio
+    int brote_de[NUM_TERRITORIOS];  //cluster de cada territorio (-1 si esta limpio)
+    int brote_miembros[NUM_TERRITORIOS];         //territorios agrupados por cluster (orden bfs)
+    int brote_inicio[NUM_TERRITORIOS + 1];       //inicio de cada cluster en brote_miembros
+    int num_brotes;                 //clusters activos
+    int brotes_validos;             //0 si un territorio cambio entre limpio e infectado
 } Mapa;
 
 //estructura de cola para bfs
@@ -198,23 +489,66 @@ typedef struct {
     int cepa_id;          //cepa con la que se infecto
 } EstadoDP;
 
+//foto de los clusters de brotes en un dia de la simulacion
+typedef struct {
+    int infectados[NUM_TERRITORIOS];  //infectados activos por territorio
+    int brote_de[NUM_TERRITORIOS];    //cluster de cada territorio (-1 si esta limpio)
+    int num_brotes;                   //clusters activos ese dia
+    int cadenas;                      //cadenas de contagio entre individuos
+    int mayor_cadena;                 //tamanio de la cadena mas grande
+} SnapshotBrotes;
+
 //tabla dp para almacenar estados por dia
 typedef struct {
     EstadoDP **tabla;     //tabla[dia][individuo]
     int num_dias;
     int num_individuos;
     Individuo **individuos_lista;  //lista plana de punteros a individuos
+    int *indice_por_id;            //posicion en individuos_lista de cada id (-1 si no esta)
+    int num_ids;                   //tamanio de indice_por_id
+    SnapshotBrotes *brotes;        //clusters por dia (contadores incrementales)
+    RedContactos *red;             //red de contactos en csr para las cadenas
+    UnionFind *uf_cadenas;         //union-find reutilizado cada dia
+    unsigned char *infectado_id;   //infectados del dia por id
+    int *tamanio_cadena;           //espacio para medir la cadena mayor
 } TablaDP;
 
+//contexto compartido por las simulaciones monte carlo de celf
+typedef struct ContextoCELF{
+    struct Mapa *grafo;             //mapa simulado
+    Individuo **por_id;             //individuos indexados por id
+    int n;                          //numero de ids
+    unsigned char *bloqueado;       //1 si no puede infectarse (vacunado, recuperado)
+    int *semillas;                  //ids de los infectados actuales
+    int num_semillas;               //cantidad de infectados actuales
+    int num_simulaciones;           //simulaciones por evaluacion
+    unsigned int semilla;           //semilla de las monedas por arista
+    int num_hilos;                  //hilos con workspace propio
+    int **marca;                    //marca[hilo][id] = sello de la simulacion
+    int **cola;                     //cola bfs por hilo
+    int **cepa;                     //cepa propagada por hilo
+    int *sello;                     //sello actual por hilo
+} ContextoCELF;
+
 //variable global para generar ids unicos
 int IDs = 0;
 
+//backend elegido por clase de tamanio (lo actualiza CompararColasPrioridad)
+int tamanios_cola[NUM_TAMANIOS_COLA] = {NUM_TERRITORIOS, 1000, 10000, 100000};
+TipoCola cola_por_tamanio[NUM_TAMANIOS_COLA] = {COLA_BINARIA, COLA_BINARIA, COLA_BINARIA, COLA_BINARIA};
+
 //declaraciones de funciones basicas
 void MENU();
 void CrearTerritorio(Territorio *t, int id, const char *nom, int cap);
 void CrearConexiones(Mapa *grafo);
 float Azar(float lim_inf, float lim_sup);
 void AgregarConexion(Mapa *grafo, int t1, int t2, float peso);
+int BuscarConexion(Mapa *grafo, int t1, int t2);
+//construye la lista de adyacencia compacta (csr) de territorios
+void ConstruirCSR(Mapa *grafo);
+void AsegurarCSR(Mapa *grafo);
+//cambia, crea o elimina (peso 0) una conexion entre territorios
+void ModificarConexion(Mapa *grafo, int t1, int t2, float peso);
 void InicializarGrafo(Mapa *grafo);
 void AgregarIndividuo(Territorio *territorio, Individuo *individuo);
 void CrearIndividuos(Mapa *grafo, int territorio_id, sqlite3 *db);
@@ -230,10 +564,33 @@ void DisminuirClave(MinHeap *heap, int vertice, float nueva_prioridad);
 void InsertarHeap(MinHeap *heap, int vertice, float prioridad);
 void LiberarHeap(MinHeap *heap);
 
+//cola de prioridad con backend intercambiable (binaria, 4-aria, pairing, radix)
+const char* NombreTipoCola(TipoCola tipo);
+ColaPrioridad* CrearColaPrioridad(TipoCola tipo, int capacidad);
+//vacia la cola sin liberar memoria para reutilizarla
+void ReiniciarCola(ColaPrioridad *cola);
+int ColaPrioridadVacia(ColaPrioridad *cola);
+void SubirCuaternario(ColaPrioridad *cola, int i);
+void BajarCuaternario(ColaPrioridad *cola, int i);
+int FusionarPareo(ColaPrioridad *cola, int a, int b);
+void CortarPareo(ColaPrioridad *cola, int v);
+int ExtraerPareo(ColaPrioridad *cola);
+int BitsSignificativos(unsigned int x);
+void MeterCubetaRadix(ColaPrioridad *cola, int vertice, unsigned int llave);
+int EntradaVigente(ColaPrioridad *cola, EntradaRadix *e);
+int ExtraerRadix(ColaPrioridad *cola);
+//inserta si el vertice no esta, disminuye su clave si ya esta
+void ColaInsertarODisminuir(ColaPrioridad *cola, int v, float prioridad);
+NodoHeap ColaExtraerMin(ColaPrioridad *cola);
+void LiberarColaPrioridad(ColaPrioridad *cola);
+
 //funciones del sistema
 void InicializarCepas(Mapa *grafo);
 void GenerarRedContactos(Mapa *grafo);
 void AgregarContacto(Individuo *ind1, Individuo *ind2, float prob);
+int QuitarDeLista(Individuo *ind, int id_otro);
+//elimina el contacto bidireccional entre dos individuos
+void EliminarContacto(Individuo *ind1, Individuo *ind2);
 int ExisteContacto(Individuo *ind, int id_otro);
 
 //funciones de ordenamiento - o(n log n)
@@ -259,7 +616,29 @@ int Desencolar(Cola *cola);
 void LiberarCola(Cola *cola);
 void IniciarBrote(Mapa *grafo, int territorio_inicial, int cepa_id, int num_infectados);
 void DetectarBrotes(Mapa *grafo);
-void BFS_Brote(Mapa *grafo, int territorio_origen, int *visitados, int *cluster, int *tam_cluster);
+void BFS_Brote(Mapa *grafo, int territorio_origen, const int *infectados, int *visitados, int *cluster, int *tam_cluster);
+//brotes incrementales: contadores por territorio y clusters recalculados solo al cambiar
+void MarcarInfectado(Mapa *grafo, Individuo *ind, int infectado);
+int CalcularComponentesBrotes(Mapa *grafo, const int *infectados, int *brote_de, int *miembros, int *inicio);
+void AsegurarBrotes(Mapa *grafo);
+int BroteDeTerritorio(Mapa *grafo, int territorio);
+int NumeroBrotes(Mapa *grafo);
+void TomarSnapshotBrotes(TablaDP *dp, Mapa *grafo, int dia);
+//cadenas de contagio entre individuos (union-find sobre la red de contactos)
+void ReiniciarUnionFind(UnionFind *uf);
+int CalcularCadenasContagio(RedContactos *red, const unsigned char *infectado, UnionFind *uf);
+int MayorCadenaContagio(UnionFind *uf, const unsigned char *infectado, int *tamanio);
+void TomarSnapshotCadenas(TablaDP *dp, int dia);
+void MostrarCadenasContagio(Mapa *grafo);
+//componentes conexas de toda la red de contactos (afforest paralelo)
+void EnlazarComponentes(int *comp, int u, int v);
+void ComprimirComponentes(int n, int *comp);
+int ComponentesAfforest(int n, const int *inicio, const int *vecino, int *comp);
+ComponentesRed* CalcularComponentesRed(RedContactos *red);
+int ComponenteDeIndividuo(ComponentesRed *cc, int id);
+void LiberarComponentesRed(ComponentesRed *cc);
+void MostrarComponentesRed(Mapa *grafo);
+void PruebaComponentesRed(int n, int grado);
 void MostrarEstadisticasBrotes(Mapa *grafo);
 
 //funciones de propagacion temporal
@@ -277,26 +656,103 @@ void GenerarReportePropagacion(TablaDP *dp, Mapa *grafo, int dia_final);
 //cuenta el numero de infectados activos en todo el sistema
 int ContarInfectadosActivos(Mapa *grafo);
 
-//funciones greedy para minimizar riesgo - o(n log n)
+//funciones greedy para minimizar riesgo - o(n + k log k)
 void CalcularRiesgoIndividuos(Mapa *grafo, IndividuoRiesgo **lista_riesgo, int *total);
 //selecciona individuos para vacunar usando algoritmo greedy
 void MinimizarRiesgoGreedy(Mapa *grafo, int num_vacunas);
-//calcula el riesgo total sumando riesgos de todos los individuos
+//retorna el riesgo total desde el acumulador - o(1)
 float CalcularRiesgoTotal(Mapa *grafo);
+//retorna el riesgo acumulado de un territorio - o(1)
+float CalcularRiesgoTerritorio(Mapa *grafo, int territorio_id);
+//aporte de un individuo al riesgo total
+float RiesgoIndividuo(Individuo *ind);
+//reconstruye el acumulador de riesgo recorriendo a todos - o(n)
+void RecalcularRiesgoTotal(Mapa *grafo);
+//aplica al acumulador el cambio de riesgo de un individuo
+void ActualizarRiesgo(Mapa *grafo, Individuo *ind, float riesgo_antes);
 //marca un individuo como vacunado reduciendo su riesgo a cero
-void VacunarIndividuo(Individuo *ind);
+void VacunarIndividuo(Mapa *grafo, Individuo *ind);
+
+//greedy perezoso (celf) con simulaciones monte carlo
+double TiempoActual();
+int HiloActual();
+float MonedaArista(unsigned int semilla, int sim, int u, int v);
+ContextoCELF* CrearContextoCELF(Mapa *grafo, int num_simulaciones);
+void LiberarContextoCELF(ContextoCELF *ctx);
+//simula una cascada de contagio con el individuo extra vacunado
+int SimularCascada(ContextoCELF *ctx, int extra, int sim, int hilo);
+double EstimarPropagacion(ContextoCELF *ctx, int extra, int paralelo);
+//selecciona vacunados minimizando la propagacion esperada
+void MinimizarRiesgoCELF(Mapa *grafo, int num_vacunas, int num_simulaciones);
 
 //funciones prim para arbol de expansion minima - o((n+m) log n)
 //encuentra el arbol de expansion minima usando prim con heap
 void AlgoritmoPrim(Mapa *grafo, int territorio_inicio);
+//calcula el arbol de prim sin imprimir
+void CalcularPrim(Mapa *grafo, int territorio_inicio, int *padre, float *clave);
 //muestra el arbol de expansion minima resultante
 void MostrarMST(Mapa *grafo, int *padre, float *clave);
 float CalcularPesoTotalMST(Mapa *grafo, int *padre);
 
+//union-find con compresion de caminos y union por rango
+UnionFind* CrearUnionFind(int n);
+int EncontrarUF(UnionFind *uf, int x);
+//une dos conjuntos, retorna 1 si estaban separados
+int UnirUF(UnionFind *uf, int a, int b);
+void LiberarUnionFind(UnionFind *uf);
+
+//kruskal y boruvka - bosque de expansion minima o(e alfa(v))
+unsigned int LlaveOrdenFloat(float f);
+void RadixSortAristas(unsigned int *llaves, int *indices, int n);
+//llena aristas[] con el bosque minimo, retorna la cantidad de aristas
+int CalcularKruskal(Mapa *grafo, AristaMST *aristas);
+int AristaMasBarata(Mapa *grafo, int a, int b);
+int CalcularBoruvka(Mapa *grafo, AristaMST *aristas);
+void MostrarBosqueMST(Mapa *grafo, AristaMST *aristas, int num_aristas, const char *titulo);
+void AlgoritmoKruskal(Mapa *grafo);
+void AlgoritmoBoruvka(Mapa *grafo);
+//mide prim, kruskal y boruvka sobre el mapa actual
+void CompararAlgoritmosMST(Mapa *grafo, int repeticiones);
+
+//bosque minimo dinamico: reparacion local por cada cambio de proximidad
+void ConstruirMSTDinamico(Mapa *grafo);
+void AsegurarMSTDinamico(Mapa *grafo);
+int CaminoEnMST(Mapa *grafo, int origen, int destino, int *padre);
+//repara el bosque tras cambiar u-v, retorna 1 si cambio su forma
+int ActualizarMSTDinamico(Mapa *grafo, int u, int v, float peso_anterior);
+float PesoMSTDinamico(Mapa *grafo);
+void SimularCambioConexion(Mapa *grafo, int t1, int t2, float peso);
+
+//dijkstra y prim genericos sobre csr con cola intercambiable
+TipoCola ElegirColaPorTamanio(int n);
+void DijkstraCSR(int n, const int *inicio, const int *vecino, const float *peso, int origen,
+                 float *distancia, int *padre, ColaPrioridad *cola);
+//dijkstra desde varias fuentes a la vez; fuente_cercana puede ser NULL
+void DijkstraMultiFuente(int n, const int *inicio, const int *vecino, const float *peso,
+                         const int *fuentes, int num_fuentes,
+                         float *distancia, int *padre, int *fuente_cercana, ColaPrioridad *cola);
+int TerritoriosInfectados(Mapa *grafo, int *fuentes);
+//reporta para cada territorio el foco activo mas cercano y su distancia
+void DistanciaFocosActivos(Mapa *grafo);
+void PrimCSR(int n, const int *inicio, const int *vecino, const float *peso, int origen,
+             float *clave, int *padre, ColaPrioridad *cola);
+void GenerarGrafoPruebaCSR(int n, int grado, int **inicio, int **vecino, float **peso);
+//microbenchmark que elige el backend mas rapido por tamanio de grafo
+void CompararColasPrioridad(Mapa *grafo);
+
+//directorio de individuos por id (arreglo plano para ids densos, hash para dispersos)
+void RegistrarIndividuo(Mapa *grafo, Individuo *ind);
+Individuo* IndividuoPorID(Mapa *grafo, int id);
+
 //funciones hash table para busqueda en o(1)
 //crea una nueva tabla hash vacia para individuos
 HashTable* CrearHashTable();
-int FuncionHash(int id);
+unsigned int FuncionHash(int id);
+//robin hood: colocacion, crecimiento por duplicacion y posicion de un id
+void ColocarRanuraHash(HashTable *tabla, int id, Individuo *individuo);
+void RedimensionarHash(HashTable *tabla, int nueva_capacidad);
+void ReservarHash(HashTable *tabla, int num_elementos);
+int PosicionHash(HashTable *tabla, int id);
 //inserta un individuo en la tabla hash
 void InsertarHash(HashTable *tabla, Individuo *individuo);
 //busca un individuo por id en la tabla hash - o(1)
@@ -305,7 +761,44 @@ void EliminarHash(HashTable *tabla, int id);
 void MostrarEstadisticasHash(HashTable *tabla);
 //inicializa la tabla hash con todos los individuos del sistema
 void InicializarHashTable(Mapa *grafo);
-void PruebaRendimientoHash(Mapa *grafo);
+//hash concurrente: lecturas sin bloqueo, escrituras por franjas, reclamacion por epocas
+void TomarCandadoGiro(int *candado);
+void SoltarCandadoGiro(int *candado);
+TablaHashConcurrente* CrearTablaHashConcurrente(int num_cubetas);
+HashConcurrente* CrearHashConcurrente(int capacidad);
+void EntrarEpoca(HashConcurrente *hc, int hilo);
+void SalirEpoca(HashConcurrente *hc, int hilo);
+void ReclamarEpocas(HashConcurrente *hc);
+void RetirarBloque(HashConcurrente *hc, void *bloque);
+Individuo* BuscarHashConcurrente(HashConcurrente *hc, int id);
+void CrecerHashConcurrente(HashConcurrente *hc);
+void InsertarHashConcurrente(HashConcurrente *hc, int id, Individuo *individuo);
+void EliminarHashConcurrente(HashConcurrente *hc, int id);
+void LiberarHashConcurrente(HashConcurrente *hc);
+void PruebaHashConcurrente(Mapa *grafo);
+
+//indice de nombres: hash de nombres internados + trie compacto de prefijos
+void NormalizarNombre(const char *origen, char *destino, int max);
+unsigned int HashNombre(const char *nombre);
+int CompararParNombre(const void *a, const void *b);
+void OrdenarParesNombre(ParNombre *pares, int n);
+void ConstruirTriePrefijos(IndiceNombres *indice, int total_caracteres);
+IndiceNombres* ConstruirIndiceNombres(Mapa *grafo);
+const int* BuscarNombreExacto(IndiceNombres *indice, const char *nombre, int *num_resultados);
+const int* BuscarNombrePrefijo(IndiceNombres *indice, const char *prefijo, int *num_resultados, int *lo, int *hi);
+void LiberarIndiceNombres(IndiceNombres *indice);
+void MostrarBusquedaNombre(Mapa *grafo, const char *texto, int por_prefijo);
+
+//prueba de rendimiento: encadenada, abierta, directorio y lineal con percentiles
+TablaEncadenada* CrearTablaEncadenada(int n);
+void InsertarEncadenada(TablaEncadenada *tabla, int id, Individuo *individuo);
+Individuo* BuscarEncadenada(TablaEncadenada *tabla, int id);
+void LiberarTablaEncadenada(TablaEncadenada *tabla);
+unsigned long long SiguienteXorshift(unsigned long long *estado);
+int CompararDouble(const void *a, const void *b);
+void LimpiarCachePrueba(unsigned char *bloque, long tam);
+int MedirConsultasHash(EstructurasPrueba *ep, int estructura, const int *consultas, int num, double *ns_lote);
+void PruebaRendimientoHash(Mapa *grafo, int poblacion);
 void LiberarHashTable(HashTable *tabla);
 
 //funciones hash table para cepas - o(1)
@@ -344,24 +837,101 @@ void AlgoritmoDijkstra(Mapa *grafo, int territorio_origen);
 void MostrarRutasCriticas(Mapa *grafo, int origen, float *distancia, int *padre);
 //reconstruye y muestra la ruta desde origen hasta destino
 void ReconstruirRuta(Mapa *grafo, int origen, int destino, int *padre);
-
-//funciones trie para clustering de cepas - o(n*l)
-//crea un nuevo nodo vacio para el trie
-NodoTrie* CrearNodoTrie();
+//version iterativa que llena un arreglo en vez de imprimir
+int ExtraerRuta(int *padre, int origen, int destino, int *ruta);
+
+//cache de distancias entre todos los pares - o(v^3) una vez, consultas o(1)
+void InvalidarDistancias(Mapa *grafo);
+//calcula distancias y siguiente salto con floyd-warshall
+void CalcularDistanciasTodosPares(Mapa *grafo);
+void AsegurarDistancias(Mapa *grafo);
+//repara la cache tras cambiar una arista, retorna los pares que cambiaron
+int ActualizarDistanciasArista(Mapa *grafo, int a, int b, float peso_anterior);
+void AplicarCambioFrontera(Mapa *grafo, int t1, int t2, float peso);
+float DistanciaTerritorios(Mapa *grafo, int origen, int destino);
+//llena ruta[] de origen a destino, retorna su longitud
+int ObtenerRuta(Mapa *grafo, int origen, int destino, int *ruta);
+//muestra las rutas criticas desde origen usando la cache
+void ConsultarRutasCriticas(Mapa *grafo, int territorio_origen);
+
+//consultas punto a punto (dijkstra bidireccional) sin imprimir
+EspacioRuta* CrearEspacioRuta();
+void LiberarEspacioRuta(EspacioRuta *ws);
+//llena ruta[] y costo, retorna la longitud (0 si no hay ruta)
+int RutaPuntoAPunto(Mapa *grafo, EspacioRuta *ws, int origen, int destino, int *ruta, float *costo);
+//resuelve varias consultas en paralelo reutilizando un espacio por hilo
+void RutasPuntoAPuntoLote(Mapa *grafo, ConsultaRuta *consultas, int num_consultas);
+void MostrarRutaPuntoAPunto(Mapa *grafo, int origen, int destino);
+void PruebaRendimientoRutas(Mapa *grafo, int repeticiones);
+
+//k rutas mas cortas sin ciclos (yen) con espacio de trabajo reutilizable
+EspacioYen* CrearEspacioYen();
+void LiberarEspacioYen(EspacioYen *ws);
+void BloquearArista(Mapa *grafo, EspacioYen *ws, int u, int v);
+int DijkstraRestringido(Mapa *grafo, EspacioYen *ws, int origen, int destino, int *ruta);
+void AgregarCandidatoYen(EspacioYen *ws, RutaK *ruta);
+//llena rutas[] con hasta k rutas en orden de costo, retorna cuantas encontro
+int KRutasMasCortas(Mapa *grafo, int origen, int destino, int k, RutaK *rutas, EspacioYen *ws);
+void ImprimirRutaK(Mapa *grafo, RutaK *ruta);
+void MostrarKRutas(Mapa *grafo, int origen, int destino, int k);
+//resuelve varias consultas (origen, destino, k) en paralelo
+void KRutasLote(Mapa *grafo, ConsultaKRutas *consultas, int num_consultas);
+void AnalizarKRutasTodosPares(Mapa *grafo, int k);
+
+//centralidad de intermediacion (brandes) en paralelo por fuentes
+RedContactos* ConstruirRedContactos(Mapa *grafo);
+void LiberarRedContactos(RedContactos *red);
+EspacioBrandes* CrearEspacioBrandes(int n, int ponderado);
+void LiberarEspacioBrandes(EspacioBrandes *ws);
+void AcumularBrandes(int n, const int *inicio, const int *vecino, const float *peso, int fuente, EspacioBrandes *ws);
+//peso NULL = no ponderado; fuentes NULL = exacta
+void CentralidadBrandes(int n, const int *inicio, const int *vecino, const float *peso,
+                        const int *fuentes, int num_fuentes, double *centralidad);
+void CentralidadTerritorios(Mapa *grafo);
+//num_muestras <= 0 calcula la version exacta
+void CentralidadIndividuos(Mapa *grafo, int num_muestras);
+
+//funciones trie radix para clustering de cepas - o(l) por operacion
+//agrega un nodo al arreglo del trie y retorna su indice
+int NuevoNodoTrie(Trie *trie, int etiqueta, int largo, int cepa_id);
+//guarda bytes en el texto del trie y retorna su posicion
+int GuardarTextoTrie(Trie *trie, const char *bytes, int largo);
 //crea un nuevo trie vacio
 Trie* CrearTrie();
+//hijo de v cuya etiqueta empieza con c (-1 si no hay)
+int HijoTrie(Trie *trie, int v, unsigned char c, int *anterior);
 //inserta una palabra en el trie asociada a un id de cepa
 void InsertarEnTrie(Trie *trie, const char *palabra, int cepa_id);
+//nodo donde termina la clave (-1 si no esta en el trie)
+int DescenderTrie(Trie *trie, const char *clave, int *fin_arista);
 //busca una palabra en el trie y retorna el id de cepa si existe
 int BuscarEnTrie(Trie *trie, const char *palabra);
 //busca todas las cepas que empiezan con un prefijo dado
 void BuscarPorPrefijo(Trie *trie, const char *prefijo, Mapa *grafo);
-void BuscarPorPrefijoRecursivo(NodoTrie *nodo, char *prefijo_actual, int nivel, Mapa *grafo, int *resultados, int *num_resultados);
+void RecolectarCepasTrie(Trie *trie, int v, int *resultados, int *num_resultados, int max_resultados);
+//busqueda aproximada: palabras a distancia de edicion <= k, podando subarboles
+int DistanciaEdicion(const char *a, const char *b);
+void RecorrerDifusoTrie(Trie *trie, int v, int profundidad, BusquedaDifusa *busqueda);
+int CompararCoincidenciaCepa(const void *a, const void *b);
+int BuscarAproximadoTrie(Trie *trie, const char *consulta, int k, CoincidenciaCepa **resultados, long *nodos_visitados);
+void BuscarAproximado(Trie *trie, const char *consulta, int k, Mapa *grafo);
+//memoria del trie radix frente a un trie de 26 punteros equivalente
+void MemoriaTrie(Trie *trie, long *bytes_radix, long *bytes_clasico);
 //inicializa el trie con todas las cepas del sistema
 void InicializarTrie(Mapa *grafo);
+//construye un registro sintetico de variantes y verifica el trie
+void PruebaTrieVariantes(int num_variantes);
+//agregados por nodo (cantidad y sumas de tasas) en un solo recorrido postorden
+void CalcularAgregadosTrie(Trie *trie, Cepa *cepas, int num_cepas);
+void AcumularSubarbolTrie(Trie *trie, int v, Cepa *cepas, int num_cepas);
+//promedios de las cepas con un prefijo en o(|prefijo|)
+int EstadisticasPrefijo(Trie *trie, const char *prefijo, double *prom_contagio, double *prom_mortalidad);
+int EsSeparadorCepa(char c);
+int CepaRepresentanteTrie(Trie *trie, int v);
+//jerarquia de clusters derivada de los prefijos del trie
+void RecorrerClustersTrie(Trie *trie, int v, int profundidad, int nivel, Mapa *grafo, ClusterCepas *clusters, int *num_clusters);
 void MostrarCepasPorCluster(Mapa *grafo);
-void LiberarTrie(NodoTrie *nodo);
-int CharAIndice(char c);
+void LiberarTrie(Trie *trie);
 
 //funciones del menu
 //muestra el menu de opciones de ordenamiento
@@ -379,6 +949,16 @@ void OrdenarPorRiesgoQuick(Mapa *grafo);
 void QuickSortRiesgo(IndividuoRiesgo *arr, int inicio, int fin);
 int ParticionarRiesgo(IndividuoRiesgo *arr, int inicio, int fin);
 
+//seleccion top-k con quickselect - o(n) promedio
+void ParticionarTresViasRiesgo(IndividuoRiesgo *arr, int inicio, int fin, int *lt, int *gt);
+void QuickSelectRiesgo(IndividuoRiesgo *arr, int inicio, int fin, int pos);
+//deja los k de mayor riesgo al inicio, ordenados
+void SeleccionarTopKRiesgo(IndividuoRiesgo *arr, int n, int k);
+void ParticionarTresVias(IndividuoOrden *arr, int inicio, int fin, int *lt, int *gt);
+void QuickSelect(IndividuoOrden *arr, int inicio, int fin, int pos);
+//deja los k mayores por valor_orden al inicio, ordenados
+void SeleccionarTopK(IndividuoOrden *arr, int n, int k);
+
 //quicksort por grado (descendente)
 void QuickSortGrado(IndividuoOrden *arr, int inicio, int fin);
 int ParticionarGrado(IndividuoOrden *arr, int inicio, int fin);
@@ -431,13 +1011,16 @@ int main(int argc, char const *argv[]){
     Mapa mundo;
     InicializarGrafo(&mundo);
     CrearConexiones(&mundo);
+    CalcularDistanciasTodosPares(&mundo);
     
     for(int i = 0; i < NUM_TERRITORIOS; i++){
         CrearIndividuos(&mundo, i, db);
     }
+    mundo.indice_nombres = ConstruirIndiceNombres(&mundo);
     
     InicializarCepas(&mundo);
     GenerarRedContactos(&mundo);
+    RecalcularRiesgoTotal(&mundo);
     InicializarSemillas(&mundo);
     AplicarSemillas(&mundo);
     
@@ -516,6 +1099,25 @@ int main(int argc, char const *argv[]){
                 }
                 
                 DetectarBrotes(&mundo);
+                
+                printf("\nAnalisis adicional (0=Ninguno, 1=Cadenas de contagio, 2=Componentes de la red, 3=Rendimiento componentes): ");
+                int analisis_brotes = 0;
+                scanf("%d", &analisis_brotes);
+                getchar();
+                if(analisis_brotes == 1){
+                    MostrarCadenasContagio(&mundo);
+                } else if(analisis_brotes == 2){
+                    MostrarComponentesRed(&mundo);
+                } else if(analisis_brotes == 3){
+                    int n_prueba, grado_prueba;
+                    printf("Individuos de la red de prueba (ej. 1000000): ");
+                    scanf("%d", &n_prueba);
+                    printf("Grado promedio (ej. 16): ");
+                    scanf("%d", &grado_prueba);
+                    getchar();
+                    PruebaComponentesRed(n_prueba, grado_prueba);
+                }
+                
                 printf("\nPresione Enter para continuar...");
                 getchar();
                 break;
@@ -555,7 +1157,16 @@ int main(int argc, char const *argv[]){
                 scanf("%d", &num_vacunas);
                 getchar();
                 
-                MinimizarRiesgoGreedy(&mundo, num_vacunas);
+                int modo_greedy;
+                printf("Modo (1=Heuristico, 2=CELF Monte Carlo): ");
+                scanf("%d", &modo_greedy);
+                getchar();
+                
+                if(modo_greedy == 2){
+                    MinimizarRiesgoCELF(&mundo, num_vacunas, NUM_SIMULACIONES_MC);
+                } else {
+                    MinimizarRiesgoGreedy(&mundo, num_vacunas);
+                }
                 
                 printf("\nPresione Enter para continuar...");
                 getchar();
@@ -563,21 +1174,115 @@ int main(int argc, char const *argv[]){
                 
             case 5:
                 printf("\nIdentificacion de rutas criticas con Dijkstra\n");
+                printf("\nOpciones:\n");
+                printf("1. Rutas desde un territorio\n");
+                printf("2. Comparar colas de prioridad\n");
+                printf("3. K rutas alternativas entre dos territorios\n");
+                printf("4. K rutas para todos los pares (lote paralelo)\n");
+                printf("5. Territorios criticos (centralidad de intermediacion)\n");
+                printf("6. Individuos criticos (centralidad de intermediacion)\n");
+                printf("7. Distancia al foco activo mas cercano\n");
+                printf("8. Ruta entre dos territorios (punto a punto)\n");
+                printf("9. Rendimiento de consultas punto a punto\n");
+                printf("10. Cerrar o modificar una frontera\n");
+                printf("Seleccione: ");
                 
-                printf("\nTerritorios disponibles:\n");
-                for(int i = 0; i < NUM_TERRITORIOS; i++){
-                    printf("%2d. %s\n", i, mundo.territorios[i].Nombre);
-                }
-                
-                int territorio_dijkstra;
-                printf("\nTerritorio origen (0-%d): ", NUM_TERRITORIOS-1);
-                scanf("%d", &territorio_dijkstra);
+                int opcion_rutas;
+                scanf("%d", &opcion_rutas);
                 getchar();
                 
-                if(territorio_dijkstra >= 0 && territorio_dijkstra < NUM_TERRITORIOS){
-                    AlgoritmoDijkstra(&mundo, territorio_dijkstra);
+                if(opcion_rutas == 1){
+                    printf("\nTerritorios disponibles:\n");
+                    for(int i = 0; i < NUM_TERRITORIOS; i++){
+                        printf("%2d. %s\n", i, mundo.territorios[i].Nombre);
+                    }
+                    
+                    int territorio_dijkstra;
+                    printf("\nTerritorio origen (0-%d): ", NUM_TERRITORIOS-1);
+                    scanf("%d", &territorio_dijkstra);
+                    getchar();
+                    
+                    if(territorio_dijkstra >= 0 && territorio_dijkstra < NUM_TERRITORIOS){
+                        ConsultarRutasCriticas(&mundo, territorio_dijkstra);
+                    } else {
+                        printf("Territorio invalido.\n");
+                    }
+                } else if(opcion_rutas == 2){
+                    CompararColasPrioridad(&mundo);
+                } else if(opcion_rutas == 3){
+                    printf("\nTerritorios disponibles:\n");
+                    for(int i = 0; i < NUM_TERRITORIOS; i++){
+                        printf("%2d. %s\n", i, mundo.territorios[i].Nombre);
+                    }
+                    
+                    int origen_k, destino_k, num_k;
+                    printf("\nTerritorio origen (0-%d): ", NUM_TERRITORIOS-1);
+                    scanf("%d", &origen_k);
+                    printf("Territorio destino (0-%d): ", NUM_TERRITORIOS-1);
+                    scanf("%d", &destino_k);
+                    printf("Numero de rutas (K): ");
+                    scanf("%d", &num_k);
+                    getchar();
+                    
+                    if(origen_k >= 0 && origen_k < NUM_TERRITORIOS &&
+                       destino_k >= 0 && destino_k < NUM_TERRITORIOS &&
+                       origen_k != destino_k && num_k > 0){
+                        MostrarKRutas(&mundo, origen_k, destino_k, num_k);
+                    } else {
+                        printf("Consulta invalida.\n");
+                    }
+                } else if(opcion_rutas == 4){
+                    int num_k;
+                    printf("\nNumero de rutas por par (K): ");
+                    scanf("%d", &num_k);
+                    getchar();
+                    
+                    if(num_k > 0){
+                        AnalizarKRutasTodosPares(&mundo, num_k);
+                    } else {
+                        printf("K invalido.\n");
+                    }
+                } else if(opcion_rutas == 5){
+                    CentralidadTerritorios(&mundo);
+                } else if(opcion_rutas == 6){
+                    int num_muestras;
+                    printf("\nFuentes a muestrear (0 = exacto): ");
+                    scanf("%d", &num_muestras);
+                    getchar();
+                    
+                    CentralidadIndividuos(&mundo, num_muestras);
+                } else if(opcion_rutas == 7){
+                    DistanciaFocosActivos(&mundo);
+                } else if(opcion_rutas == 8){
+                    int origen_p, destino_p;
+                    printf("\nTerritorio origen (0-%d): ", NUM_TERRITORIOS-1);
+                    scanf("%d", &origen_p);
+                    printf("Territorio destino (0-%d): ", NUM_TERRITORIOS-1);
+                    scanf("%d", &destino_p);
+                    getchar();
+                    
+                    if(origen_p >= 0 && origen_p < NUM_TERRITORIOS && destino_p >= 0 && destino_p < NUM_TERRITORIOS){
+                        MostrarRutaPuntoAPunto(&mundo, origen_p, destino_p);
+                    } else {
+                        printf("Territorio invalido.\n");
+                    }
+                } else if(opcion_rutas == 9){
+                    PruebaRendimientoRutas(&mundo, 1000);
+                } else if(opcion_rutas == 10){
+                    int t1_frontera, t2_frontera;
+                    float peso_frontera;
+                    printf("\nTerritorio 1 (0-%d): ", NUM_TERRITORIOS-1);
+                    scanf("%d", &t1_frontera);
+                    printf("Territorio 2 (0-%d): ", NUM_TERRITORIOS-1);
+                    scanf("%d", &t2_frontera);
+                    printf("Nueva proximidad (0 = cerrar frontera, max 1.0): ");
+                    scanf("%f", &peso_frontera);
+                    getchar();
+                    
+                    if(peso_frontera > 1.0) peso_frontera = 1.0;
+                    AplicarCambioFrontera(&mundo, t1_frontera, t2_frontera, peso_frontera);
                 } else {
-                    printf("Territorio invalido.\n");
+                    printf("\nOpcion invalida\n");
                 }
                 
                 printf("\nPresione Enter para continuar...");
@@ -585,19 +1290,53 @@ int main(int argc, char const *argv[]){
                 break;
                 
             case 6:
-                printf("\nCalculo de rutas optimas de contencion con Prim\n");
-                
-                printf("\nTerritorios disponibles:\n");
-                for(int i = 0; i < NUM_TERRITORIOS; i++){
-                    printf("%2d. %s\n", i, mundo.territorios[i].Nombre);
-                }
+                printf("\nCalculo de rutas optimas de contencion (MST)\n");
+                printf("\nOpciones:\n");
+                printf("1. Prim\n");
+                printf("2. Kruskal\n");
+                printf("3. Boruvka\n");
+                printf("4. Comparar rendimiento\n");
+                printf("5. ¿Que pasaria si cambia una conexion? (MST dinamico)\n");
+                printf("Seleccione: ");
                 
-                int territorio_prim;
-                printf("\nTerritorio de inicio para MST (0-%d): ", NUM_TERRITORIOS-1);
-                scanf("%d", &territorio_prim);
+                int opcion_mst;
+                scanf("%d", &opcion_mst);
                 getchar();
                 
-                AlgoritmoPrim(&mundo, territorio_prim);
+                if(opcion_mst == 1){
+                    printf("\nTerritorios disponibles:\n");
+                    for(int i = 0; i < NUM_TERRITORIOS; i++){
+                        printf("%2d. %s\n", i, mundo.territorios[i].Nombre);
+                    }
+                    
+                    int territorio_prim;
+                    printf("\nTerritorio de inicio para MST (0-%d): ", NUM_TERRITORIOS-1);
+                    scanf("%d", &territorio_prim);
+                    getchar();
+                    
+                    AlgoritmoPrim(&mundo, territorio_prim);
+                } else if(opcion_mst == 2){
+                    AlgoritmoKruskal(&mundo);
+                } else if(opcion_mst == 3){
+                    AlgoritmoBoruvka(&mundo);
+                } else if(opcion_mst == 4){
+                    CompararAlgoritmosMST(&mundo, 10000);
+                } else if(opcion_mst == 5){
+                    int t1_cambio, t2_cambio;
+                    float peso_cambio;
+                    printf("\nTerritorio 1 (0-%d): ", NUM_TERRITORIOS-1);
+                    scanf("%d", &t1_cambio);
+                    printf("Territorio 2 (0-%d): ", NUM_TERRITORIOS-1);
+                    scanf("%d", &t2_cambio);
+                    printf("Nueva proximidad (0 = cerrar frontera, max 1.0): ");
+                    scanf("%f", &peso_cambio);
+                    getchar();
+                    
+                    if(peso_cambio > 1.0) peso_cambio = 1.0;
+                    SimularCambioConexion(&mundo, t1_cambio, t2_cambio, peso_cambio);
+                } else {
+                    printf("\nOpcion invalida\n");
+                }
                 
                 printf("\nPresione Enter para continuar...");
                 getchar();
@@ -610,6 +1349,8 @@ int main(int argc, char const *argv[]){
                 printf("2. Buscar cepa por nombre exacto\n");
                 printf("3. Buscar cepas por prefijo\n");
                 printf("4. Mostrar clustering completo\n");
+                printf("5. Busqueda aproximada (tolera errores de escritura)\n");
+                printf("6. Prueba con registro de variantes\n");
                 printf("Seleccione: ");
                 
                 int opcion_trie;
@@ -643,6 +1384,18 @@ int main(int argc, char const *argv[]){
                                 printf("  Tiempo recuperación: %d días\n", cepa->Tiempo_recuperacion);
                             } else {
                                 printf("\n✗ Cepa no encontrada\n");
+                                
+                                // Sugerir nombres parecidos (errores de escritura)
+                                CoincidenciaCepa *sugerencias;
+                                int num_sugerencias = BuscarAproximadoTrie(mundo.trie_cepas, nombre_buscar, 2, &sugerencias, NULL);
+                                if(num_sugerencias > 0){
+                                    printf("  Quizas quiso decir:");
+                                    for(int i = 0; i < num_sugerencias && i < 5; i++){
+                                        printf(" %s", mundo.cepas[sugerencias[i].cepa_id].Nombre);
+                                    }
+                                    printf("\n");
+                                }
+                                free(sugerencias);
                             }
                         }
                         break;
@@ -664,6 +1417,30 @@ int main(int argc, char const *argv[]){
                         MostrarCepasPorCluster(&mundo);
                         break;
                         
+                    case 5:
+                        if(mundo.trie_cepas == NULL){
+                            printf("\nPrimero debe inicializar el Trie (opcion 1)\n");
+                        } else {
+                            char consulta[30];
+                            int distancia_max;
+                            printf("\nNombre aproximado (ej: Alpa-Flu-1): ");
+                            fgets(consulta, 30, stdin);
+                            consulta[strcspn(consulta, "\n")] = 0;
+                            printf("Distancia de edicion maxima (ej: 2): ");
+                            scanf("%d", &distancia_max);
+                            
+                            BuscarAproximado(mundo.trie_cepas, consulta, distancia_max, &mundo);
+                        }
+                        break;
+                        
+                    case 6: {
+                        int num_variantes;
+                        printf("\nCantidad de variantes sinteticas (ej: 20000): ");
+                        scanf("%d", &num_variantes);
+                        PruebaTrieVariantes(num_variantes);
+                        break;
+                    }
+                        
                     default:
                         printf("\nOpcion invalida\n");
                         break;
@@ -678,12 +1455,17 @@ int main(int argc, char const *argv[]){
                 printf("\nOpciones:\n");
                 printf("--- Hash Table Individuos ---\n");
                 printf("1. Inicializar Hash Table Individuos\n");
-                printf("2. Buscar individuo por ID - O(1)\n");
+                printf("2. Buscar individuo por ID - O(1) (directorio)\n");
                 printf("3. Mostrar estadisticas Hash Individuos\n");
                 printf("4. Prueba de rendimiento\n");
                 printf("--- Hash Table Cepas ---\n");
                 printf("5. Inicializar Hash Table Cepas\n");
                 printf("6. Buscar cepa por ID - O(1)\n");
+                printf("--- Concurrencia ---\n");
+                printf("7. Prueba de hash concurrente (lectores + escritor)\n");
+                printf("--- Nombres de individuos ---\n");
+                printf("8. Buscar individuos por nombre exacto\n");
+                printf("9. Buscar individuos por prefijo de nombre\n");
                 printf("Seleccione: ");
                 
                 int opcion_hash;
@@ -696,15 +1478,14 @@ int main(int argc, char const *argv[]){
                         break;
                         
                     case 2:
-                        if(mundo.hash_individuos == NULL){
-                            printf("\nPrimero debe inicializar la Hash Table (opcion 1)\n");
-                        } else {
+                        {
+                            //ids densos: directorio directo; la hash queda para ids dispersos
                             int id_buscar;
                             printf("\nID del individuo a buscar: ");
                             scanf("%d", &id_buscar);
                             getchar();
                             
-                            Individuo *resultado = BuscarHash(mundo.hash_individuos, id_buscar);
+                            Individuo *resultado = IndividuoPorID(&mundo, id_buscar);
                             
                             if(resultado != NULL){
                                 printf("\n✓ INDIVIDUO ENCONTRADO en O(1):\n");
@@ -722,13 +1503,7 @@ int main(int argc, char const *argv[]){
                                     printf("  Cepa: %s\n", mundo.cepas[resultado->Cepa_ID].Nombre);
                                 }
                                 
-                                int num_contactos = 0;
-                                Contacto *c = resultado->contactos;
-                                while(c != NULL){
-                                    num_contactos++;
-                                    c = c->sgt;
-                                }
-                                printf("  Numero de contactos: %d\n", num_contactos);
+                                printf("  Numero de contactos: %d\n", resultado->Grado);
                             } else {
                                 printf("\n✗ Individuo con ID %d no encontrado\n", id_buscar);
                             }
@@ -744,10 +1519,27 @@ int main(int argc, char const *argv[]){
                         break;
                         
                     case 4:
-                        if(mundo.hash_individuos == NULL){
-                            printf("\nPrimero debe inicializar la Hash Table (opcion 1)\n");
-                        } else {
-                            PruebaRendimientoHash(&mundo);
+                        {
+                            int poblacion_prueba;
+                            printf("\nPoblacion de prueba (0 = individuos reales, ej. 1000000): ");
+                            scanf("%d", &poblacion_prueba);
+                            getchar();
+                            PruebaRendimientoHash(&mundo, poblacion_prueba);
+                        }
+                        break;
+                    
+                    case 7:
+                        PruebaHashConcurrente(&mundo);
+                        break;
+                    
+                    case 8:
+                    case 9:
+                        {
+                            char texto_nombre[50];
+                            printf(opcion_hash == 8 ? "\nNombre a buscar: " : "\nPrefijo a buscar: ");
+                            fgets(texto_nombre, 50, stdin);
+                            texto_nombre[strcspn(texto_nombre, "\n")] = 0;
+                            MostrarBusquedaNombre(&mundo, texto_nombre, opcion_hash == 9);
                         }
                         break;
                     
@@ -855,19 +1647,153 @@ void CrearConexiones(Mapa *grafo){
     AgregarConexion(grafo, EUA, JAPON, 0.70);
 }
 
+//busca la conexion entre dos territorios en la lista de aristas, -1 si no existe
+int BuscarConexion(Mapa *grafo, int t1, int t2){
+    if(grafo->matrix[t1][t2] <= 0.0) return -1;
+    
+    for(int e = 0; e < grafo->num_conexiones; e++){
+        ConexionTerritorio *c = &grafo->conexiones[e];
+        if((c->u_territorio == t1 && c->v_territorio == t2) ||
+           (c->u_territorio == t2 && c->v_territorio == t1)){
+            return e;
+        }
+    }
+    return -1;
+}
+
+//agrega una conexion (o actualiza su peso si ya existe)
 void AgregarConexion(Mapa *grafo, int t1, int t2, float peso){
+    int e = BuscarConexion(grafo, t1, t2);
+    
+    if(e == -1){
+        e = grafo->num_conexiones;
+        grafo->conexiones[e].u_territorio = t1;
+        grafo->conexiones[e].v_territorio = t2;
+        grafo->num_conexiones++;
+    }
+    grafo->conexiones[e].peso_proximidad = peso;
+    
     grafo->matrix[t1][t2] = peso;
     grafo->matrix[t2][t1] = peso;
-    grafo->num_conexiones++;
+    grafo->csr_valido = 0;
+    grafo->mst_valido = 0;
+    grafo->brotes_validos = 0;
+    InvalidarDistancias(grafo);
+}
+
+//cambia el peso de una conexion existente, la crea o la elimina (peso 0)
+//si el bosque minimo dinamico o la cache de distancias estan vigentes se reparan localmente
+void ModificarConexion(Mapa *grafo, int t1, int t2, float peso){
+    if(t1 < 0 || t1 >= NUM_TERRITORIOS || t2 < 0 || t2 >= NUM_TERRITORIOS || t1 == t2) return;
+    
+    int mst_vigente = grafo->mst_valido;
+    int distancias_vigentes = grafo->distancias_validas;
+    float peso_anterior = grafo->matrix[t1][t2];
+    
+    if(peso > 0.0){
+        AgregarConexion(grafo, t1, t2, peso);
+    } else {
+        int e = BuscarConexion(grafo, t1, t2);
+        if(e == -1) return;
+        
+        //eliminar moviendo la ultima arista a su lugar
+        grafo->num_conexiones--;
+        grafo->conexiones[e] = grafo->conexiones[grafo->num_conexiones];
+        
+        grafo->matrix[t1][t2] = SIN_CONEXION;
+        grafo->matrix[t2][t1] = SIN_CONEXION;
+        grafo->csr_valido = 0;
+        grafo->brotes_validos = 0;
+        InvalidarDistancias(grafo);
+    }
+    
+    if(mst_vigente){
+        ActualizarMSTDinamico(grafo, t1, t2, peso_anterior);
+        grafo->mst_valido = 1;
+    }
+    if(distancias_vigentes){
+        ActualizarDistanciasArista(grafo, t1, t2, peso_anterior);
+        grafo->distancias_validas = 1;
+    }
+}
+
+//construye la representacion csr (lista de adyacencia compacta) - o(v + e)
+//los vecinos de cada fila quedan en orden ascendente, igual que al recorrer la matriz
+void ConstruirCSR(Mapa *grafo){
+    int *inicio = grafo->csr_inicio;
+    
+    for(int v = 0; v <= NUM_TERRITORIOS; v++){
+        inicio[v] = 0;
+    }
+    for(int e = 0; e < grafo->num_conexiones; e++){
+        inicio[grafo->conexiones[e].u_territorio + 1]++;
+        inicio[grafo->conexiones[e].v_territorio + 1]++;
+    }
+    for(int v = 0; v < NUM_TERRITORIOS; v++){
+        inicio[v + 1] += inicio[v];
+    }
+    
+    int pos[NUM_TERRITORIOS];
+    for(int v = 0; v < NUM_TERRITORIOS; v++){
+        pos[v] = inicio[v];
+    }
+    for(int e = 0; e < grafo->num_conexiones; e++){
+        ConexionTerritorio *c = &grafo->conexiones[e];
+        grafo->csr_vecino[pos[c->u_territorio]] = c->v_territorio;
+        grafo->csr_peso[pos[c->u_territorio]++] = c->peso_proximidad;
+        grafo->csr_vecino[pos[c->v_territorio]] = c->u_territorio;
+        grafo->csr_peso[pos[c->v_territorio]++] = c->peso_proximidad;
+    }
+    
+    //ordenar cada fila por vecino (insercion, las filas son cortas)
+    for(int v = 0; v < NUM_TERRITORIOS; v++){
+        for(int i = inicio[v] + 1; i < inicio[v + 1]; i++){
+            int vecino = grafo->csr_vecino[i];
+            float peso = grafo->csr_peso[i];
+            int j = i - 1;
+            while(j >= inicio[v] && grafo->csr_vecino[j] > vecino){
+                grafo->csr_vecino[j + 1] = grafo->csr_vecino[j];
+                grafo->csr_peso[j + 1] = grafo->csr_peso[j];
+                j--;
+            }
+            grafo->csr_vecino[j + 1] = vecino;
+            grafo->csr_peso[j + 1] = peso;
+        }
+    }
+    
+    grafo->csr_valido = 1;
+}
+
+//reconstruye el csr solo si la topologia cambio
+void AsegurarCSR(Mapa *grafo){
+    if(!grafo->csr_valido){
+        ConstruirCSR(grafo);
+    }
 }
 
 void InicializarGrafo(Mapa *grafo){
     grafo->num_territorios = NUM_TERRITORIOS;
     grafo->num_conexiones = 0;
     grafo->hash_individuos = NULL;
+    grafo->directorio = NULL;
+    grafo->capacidad_directorio = 0;
+    grafo->ids_dispersos = NULL;
+    grafo->indice_nombres = NULL;
     grafo->hash_cepas = NULL;
     grafo->trie_cepas = NULL;
     grafo->num_semillas = 0;
+    grafo->riesgo_total = 0.0;
+    for(int t = 0; t < NUM_TERRITORIOS; t++){
+        grafo->riesgo_territorio[t] = 0.0;
+    }
+    grafo->distancias_validas = 0;
+    grafo->csr_valido = 0;
+    grafo->mst_valido = 0;
+    for(int t = 0; t < NUM_TERRITORIOS; t++){
+        grafo->infectados_territorio[t] = 0;
+    }
+    grafo->num_brotes = 0;
+    grafo->brotes_validos = 0;
     
     CrearTerritorio(&grafo->territorios[CHINA], 0, "China", 150);
     CrearTerritorio(&grafo->territorios[JAPON], 1, "Japon", 120);
@@ -953,9 +1879,11 @@ void CrearIndividuos(Mapa *grafo, int territorio_id, sqlite3 *db){
         P->Recuperado = 0;
         P->Fallecido = 0;
         P->Cepa_ID = -1;
+        P->Grado = 0;
         P->contactos = NULL;
 
         AgregarIndividuo(territorio, P);
+        RegistrarIndividuo(grafo, P);
         IDs++;
     }
     
@@ -1123,105 +2051,502 @@ void LiberarHeap(MinHeap *heap){
 }
 
 //=============================================================
-//inicializacion de las 50 cepas virales
+//colas de prioridad intercambiables para dijkstra y prim
 //=============================================================
 
-//crea las 50 cepas con nombres y caracteristicas aleatorias
-void InicializarCepas(Mapa *grafo){
-    const char *prefijos[] = {"Alpha", "Beta", "Gamma", "Delta", "Epsilon", 
-                              "Zeta", "Eta", "Theta", "Iota", "Kappa"};
-    const char *sufijos[] = {"Flu", "Pox", "Fever", "Virus", "Strain"};
+//nombre legible de cada backend
+const char* NombreTipoCola(TipoCola tipo){
+    switch(tipo){
+        case COLA_BINARIA: return "Binaria";
+        case COLA_CUATERNARIA: return "4-aria";
+        case COLA_EMPAREJAMIENTO: return "Pairing";
+        case COLA_RADIX: return "Radix";
+        default: return "?";
+    }
+}
+
+//crea una cola de prioridad para vertices 0..capacidad-1 con el backend indicado
+ColaPrioridad* CrearColaPrioridad(TipoCola tipo, int capacidad){
+    ColaPrioridad *cola = (ColaPrioridad*)calloc(1, sizeof(ColaPrioridad));
+    cola->tipo = tipo;
+    cola->capacidad = capacidad;
+    cola->estado = (int*)calloc(capacidad, sizeof(int));
+    cola->raiz = -1;
     
-    grafo->num_cepas = NUM_CEPAS;
+    switch(tipo){
+        case COLA_BINARIA:
+            cola->binario = CrearMinHeap(capacidad);
+            break;
+        case COLA_CUATERNARIA:
+            cola->nodos = (NodoHeap*)malloc(capacidad * sizeof(NodoHeap));
+            cola->posiciones = (int*)malloc(capacidad * sizeof(int));
+            break;
+        case COLA_EMPAREJAMIENTO:
+            cola->pareo = (NodoPareo*)malloc(capacidad * sizeof(NodoPareo));
+            cola->pila = (int*)malloc(capacidad * sizeof(int));
+            break;
+        case COLA_RADIX:
+            cola->llave_actual = (unsigned int*)malloc(capacidad * sizeof(unsigned int));
+            break;
+        default:
+            break;
+    }
     
-    for(int i = 0; i < NUM_CEPAS; i++){
-        grafo->cepas[i].ID = i;
-        
-        sprintf(grafo->cepas[i].Nombre, "%s-%s-%d", 
-                prefijos[i % 10], 
-                sufijos[i % 5], 
-                i + 1);
+    return cola;
+}
+
+//vacia la cola para reutilizarla en otra consulta sin volver a reservar memoria
+void ReiniciarCola(ColaPrioridad *cola){
+    memset(cola->estado, 0, cola->capacidad * sizeof(int));
+    cola->size = 0;
+    cola->raiz = -1;
+    cola->ultima = 0;
+    
+    if(cola->binario != NULL){
+        cola->binario->size = 0;
+        for(int i = 0; i < cola->capacidad; i++){
+            cola->binario->posiciones[i] = -1;
+        }
+    }
+    for(int b = 0; b < 33; b++){
+        cola->cubeta_size[b] = 0;
+    }
+}
+
+//verifica si la cola esta vacia
+int ColaPrioridadVacia(ColaPrioridad *cola){
+    return cola->size == 0;
+}
+
+//--- heap 4-ario ---
+
+//sube el nodo en i hasta su lugar en el heap 4-ario
+void SubirCuaternario(ColaPrioridad *cola, int i){
+    NodoHeap nodo = cola->nodos[i];
+    
+    while(i > 0){
+        int p = (i - 1) / 4;
+        if(cola->nodos[p].prioridad <= nodo.prioridad) break;
+        cola->nodos[i] = cola->nodos[p];
+        cola->posiciones[cola->nodos[i].vertice] = i;
+        i = p;
+    }
+    
+    cola->nodos[i] = nodo;
+    cola->posiciones[nodo.vertice] = i;
+}
+
+//baja el nodo en i hasta su lugar en el heap 4-ario
+void BajarCuaternario(ColaPrioridad *cola, int i){
+    NodoHeap nodo = cola->nodos[i];
+    
+    while(1){
+        int primero = 4 * i + 1;
+        if(primero >= cola->size) break;
         
-        grafo->cepas[i].Tasa_contagio = Azar(0.1, 0.9);
-        grafo->cepas[i].Tasa_mortalidad = Azar(0.01, 0.15);
-        grafo->cepas[i].Tiempo_incubacion = (int)Azar(1, 14);
-        grafo->cepas[i].Tiempo_recuperacion = (int)Azar(7, 21);
+        int ultimo = primero + 4 < cola->size ? primero + 4 : cola->size;
+        int menor = primero;
+        for(int h = primero + 1; h < ultimo; h++){
+            if(cola->nodos[h].prioridad < cola->nodos[menor].prioridad) menor = h;
+        }
         
-        strcpy(grafo->cepas[i].Sintomas, "Fiebre, tos, fatiga");
+        if(cola->nodos[menor].prioridad >= nodo.prioridad) break;
+        cola->nodos[i] = cola->nodos[menor];
+        cola->posiciones[cola->nodos[i].vertice] = i;
+        i = menor;
     }
+    
+    cola->nodos[i] = nodo;
+    cola->posiciones[nodo.vertice] = i;
 }
 
-//=============================================================
-//generacion de la red de contactos entre individuos
-//=============================================================
+//--- pairing heap ---
 
-//agrega un contacto bidireccional entre dos individuos
-void AgregarContacto(Individuo *ind1, Individuo *ind2, float prob){
-    if(ind1 == NULL || ind2 == NULL) return;
+//fusiona dos raices del pairing heap y retorna la nueva raiz
+int FusionarPareo(ColaPrioridad *cola, int a, int b){
+    if(a == -1) return b;
+    if(b == -1) return a;
     
-    Contacto *nuevo = (Contacto*)malloc(sizeof(Contacto));
-    nuevo->u_individuo = ind1->ID;
-    nuevo->v_individuo = ind2->ID;
-    nuevo->prob_contagio = prob;
-    nuevo->sgt = ind1->contactos;
-    ind1->contactos = nuevo;
+    NodoPareo *p = cola->pareo;
+    if(p[b].prioridad < p[a].prioridad){
+        int temp = a;
+        a = b;
+        b = temp;
+    }
     
-    Contacto *nuevo2 = (Contacto*)malloc(sizeof(Contacto));
-    nuevo2->u_individuo = ind2->ID;
-    nuevo2->v_individuo = ind1->ID;
-    nuevo2->prob_contagio = prob;
-    nuevo2->sgt = ind2->contactos;
-    ind2->contactos = nuevo2;
+    //b pasa a ser el primer hijo de a
+    p[b].hermano = p[a].hijo;
+    if(p[a].hijo != -1) p[p[a].hijo].anterior = b;
+    p[b].anterior = a;
+    p[a].hijo = b;
+    p[a].hermano = -1;
+    p[a].anterior = -1;
+    
+    return a;
 }
 
-//verifica si ya existe un contacto entre dos individuos
-int ExisteContacto(Individuo *ind, int id_otro){
-    if(ind == NULL) return 0;
+//separa al vertice v de su padre y hermanos
+void CortarPareo(ColaPrioridad *cola, int v){
+    NodoPareo *p = cola->pareo;
+    int ant = p[v].anterior;
     
-    Contacto *actual = ind->contactos;
-    while(actual != NULL){
-        if(actual->v_individuo == id_otro) return 1;
-        actual = actual->sgt;
+    if(ant == -1) return;
+    
+    if(p[ant].hijo == v){
+        p[ant].hijo = p[v].hermano;
+    } else {
+        p[ant].hermano = p[v].hermano;
     }
-    return 0;
+    if(p[v].hermano != -1) p[p[v].hermano].anterior = ant;
+    
+    p[v].hermano = -1;
+    p[v].anterior = -1;
 }
 
-void GenerarRedContactos(Mapa *grafo){
-    for(int t = 0; t < NUM_TERRITORIOS; t++){
-        Territorio *territorio = &grafo->territorios[t];
+//extrae la raiz del pairing heap fusionando sus hijos en dos pasadas
+int ExtraerPareo(ColaPrioridad *cola){
+    NodoPareo *p = cola->pareo;
+    int r = cola->raiz;
+    int k = 0;
+    int c = p[r].hijo;
+    
+    //primera pasada: fusionar hijos por pares de izquierda a derecha
+    while(c != -1){
+        int a = c;
+        int b = p[a].hermano;
+        c = (b != -1) ? p[b].hermano : -1;
         
-        if(territorio->num_individuos == 0) continue;
+        p[a].hermano = p[a].anterior = -1;
+        if(b != -1) p[b].hermano = p[b].anterior = -1;
         
-        for(int i = 0; i < territorio->num_individuos; i++){
-            Individuo *ind1 = territorio->individuos[i];
-            if(ind1 == NULL) continue;
-            
-            int num_contactos = (int)Azar(2, ind1->Grado_inicial);
-            if(num_contactos > territorio->num_individuos - 1){
-                num_contactos = territorio->num_individuos - 1;
-            }
-            
-            int contactos_creados = 0;
-            
-            for(int intentos = 0; intentos < num_contactos * 3 && contactos_creados < num_contactos; intentos++){
-                int idx_aleatorio = (int)Azar(0, territorio->num_individuos);
-                
-                if(idx_aleatorio >= territorio->num_individuos) continue;
-                if(idx_aleatorio == i) continue;
-                
-                Individuo *ind2 = territorio->individuos[idx_aleatorio];
-                if(ind2 == NULL) continue;
-                
-                if(!ExisteContacto(ind1, ind2->ID)){
-                    float prob = Azar(0.1, 0.8);
+        cola->pila[k++] = FusionarPareo(cola, a, b);
+    }
+    
+    //segunda pasada: fusionar de derecha a izquierda
+    int nueva = -1;
+    while(k > 0){
+        nueva = FusionarPareo(cola, cola->pila[--k], nueva);
+    }
+    
+    p[r].hijo = -1;
+    cola->raiz = nueva;
+    return r;
+}
+
+//--- radix heap ---
+
+//numero de bits significativos de x (0 si x == 0)
+int BitsSignificativos(unsigned int x){
+#ifdef __GNUC__
+    return x == 0 ? 0 : 32 - __builtin_clz(x);
+#else
+    int bits = 0;
+    while(x){
+        bits++;
+        x >>= 1;
+    }
+    return bits;
+#endif
+}
+
+//agrega una entrada a la cubeta que corresponde a su llave
+void MeterCubetaRadix(ColaPrioridad *cola, int vertice, unsigned int llave){
+    int b = BitsSignificativos(llave ^ cola->ultima);
+    
+    if(cola->cubeta_size[b] == cola->cubeta_cap[b]){
+        cola->cubeta_cap[b] = cola->cubeta_cap[b] ? 2 * cola->cubeta_cap[b] : 16;
+        cola->cubetas[b] = (EntradaRadix*)realloc(cola->cubetas[b], cola->cubeta_cap[b] * sizeof(EntradaRadix));
+    }
+    
+    cola->cubetas[b][cola->cubeta_size[b]].vertice = vertice;
+    cola->cubetas[b][cola->cubeta_size[b]].llave = llave;
+    cola->cubeta_size[b]++;
+}
+
+//una entrada es vigente si su vertice sigue en la cola con esa misma llave
+int EntradaVigente(ColaPrioridad *cola, EntradaRadix *e){
+    return cola->estado[e->vertice] == 1 && cola->llave_actual[e->vertice] == e->llave;
+}
+
+//extrae el vertice con menor llave del radix heap
+int ExtraerRadix(ColaPrioridad *cola){
+    while(1){
+        //la cubeta 0 solo contiene llaves iguales a la ultima extraida
+        while(cola->cubeta_size[0] > 0){
+            EntradaRadix e = cola->cubetas[0][--cola->cubeta_size[0]];
+            if(EntradaVigente(cola, &e)) return e.vertice;
+        }
+        
+        int b = 1;
+        while(b < 33 && cola->cubeta_size[b] == 0) b++;
+        if(b == 33) return -1;
+        
+        //nueva ultima = menor llave vigente de la cubeta; redistribuir hacia abajo
+        unsigned int minima = 0xFFFFFFFFu;
+        int vigentes = 0;
+        for(int i = 0; i < cola->cubeta_size[b]; i++){
+            if(EntradaVigente(cola, &cola->cubetas[b][i]) && cola->cubetas[b][i].llave <= minima){
+                minima = cola->cubetas[b][i].llave;
+                vigentes++;
+            }
+        }
+        
+        int tamanio = cola->cubeta_size[b];
+        cola->cubeta_size[b] = 0;
+        if(vigentes == 0) continue;
+        
+        cola->ultima = minima;
+        for(int i = 0; i < tamanio; i++){
+            EntradaRadix e = cola->cubetas[b][i];
+            if(EntradaVigente(cola, &e)){
+                MeterCubetaRadix(cola, e.vertice, e.llave);
+            }
+        }
+    }
+}
+
+//--- interfaz comun ---
+
+//insercion perezosa: inserta v si no esta, disminuye su clave si ya esta
+//los vertices ya extraidos se ignoran
+void ColaInsertarODisminuir(ColaPrioridad *cola, int v, float prioridad){
+    if(cola->estado[v] == 2) return;
+    int nuevo = (cola->estado[v] == 0);
+    
+    if(nuevo){
+        cola->estado[v] = 1;
+        cola->size++;
+    }
+    
+    switch(cola->tipo){
+        case COLA_BINARIA:
+            if(nuevo) InsertarHeap(cola->binario, v, prioridad);
+            else DisminuirClave(cola->binario, v, prioridad);
+            break;
+            
+        case COLA_CUATERNARIA:
+            if(nuevo){
+                cola->nodos[cola->size - 1].vertice = v;
+                cola->nodos[cola->size - 1].prioridad = prioridad;
+                SubirCuaternario(cola, cola->size - 1);
+            } else {
+                cola->nodos[cola->posiciones[v]].prioridad = prioridad;
+                SubirCuaternario(cola, cola->posiciones[v]);
+            }
+            break;
+            
+        case COLA_EMPAREJAMIENTO:
+            if(nuevo){
+                cola->pareo[v].hijo = cola->pareo[v].hermano = cola->pareo[v].anterior = -1;
+            } else if(v != cola->raiz){
+                CortarPareo(cola, v);
+            }
+            cola->pareo[v].prioridad = prioridad;
+            if(v != cola->raiz) cola->raiz = FusionarPareo(cola, cola->raiz, v);
+            break;
+            
+        case COLA_RADIX: {
+            //prioridades no negativas: los bits del float conservan el orden
+            unsigned int llave;
+            memcpy(&llave, &prioridad, sizeof(llave));
+            cola->llave_actual[v] = llave;
+            MeterCubetaRadix(cola, v, llave);
+            break;
+        }
+        
+        default:
+            break;
+    }
+}
+
+//extrae el vertice de menor prioridad (vertice -1 si la cola esta vacia)
+NodoHeap ColaExtraerMin(ColaPrioridad *cola){
+    NodoHeap resultado = {-1, -1.0};
+    if(ColaPrioridadVacia(cola)) return resultado;
+    
+    switch(cola->tipo){
+        case COLA_BINARIA:
+            resultado = ExtraerMin(cola->binario);
+            break;
+            
+        case COLA_CUATERNARIA:
+            resultado = cola->nodos[0];
+            cola->nodos[0] = cola->nodos[cola->size - 1];
+            cola->size--;
+            if(cola->size > 0) BajarCuaternario(cola, 0);
+            cola->size++;
+            break;
+            
+        case COLA_EMPAREJAMIENTO:
+            resultado.prioridad = cola->pareo[cola->raiz].prioridad;
+            resultado.vertice = ExtraerPareo(cola);
+            break;
+            
+        case COLA_RADIX:
+            resultado.vertice = ExtraerRadix(cola);
+            memcpy(&resultado.prioridad, &cola->llave_actual[resultado.vertice], sizeof(float));
+            break;
+            
+        default:
+            break;
+    }
+    
+    cola->estado[resultado.vertice] = 2;
+    cola->size--;
+    return resultado;
+}
+
+//libera la memoria de la cola de prioridad
+void LiberarColaPrioridad(ColaPrioridad *cola){
+    if(cola->binario != NULL) LiberarHeap(cola->binario);
+    free(cola->nodos);
+    free(cola->posiciones);
+    free(cola->pareo);
+    free(cola->pila);
+    free(cola->llave_actual);
+    for(int b = 0; b < 33; b++){
+        free(cola->cubetas[b]);
+    }
+    free(cola->estado);
+    free(cola);
+}
+
+//=============================================================
+//inicializacion de las 50 cepas virales
+//=============================================================
+
+//crea las 50 cepas con nombres y caracteristicas aleatorias
+void InicializarCepas(Mapa *grafo){
+    const char *prefijos[] = {"Alpha", "Beta", "Gamma", "Delta", "Epsilon", 
+                              "Zeta", "Eta", "Theta", "Iota", "Kappa"};
+    const char *sufijos[] = {"Flu", "Pox", "Fever", "Virus", "Strain"};
+    
+    grafo->num_cepas = NUM_CEPAS;
+    
+    for(int i = 0; i < NUM_CEPAS; i++){
+        grafo->cepas[i].ID = i;
+        
+        sprintf(grafo->cepas[i].Nombre, "%s-%s-%d", 
+                prefijos[i % 10], 
+                sufijos[i % 5], 
+                i + 1);
+        
+        grafo->cepas[i].Tasa_contagio = Azar(0.1, 0.9);
+        grafo->cepas[i].Tasa_mortalidad = Azar(0.01, 0.15);
+        grafo->cepas[i].Tiempo_incubacion = (int)Azar(1, 14);
+        grafo->cepas[i].Tiempo_recuperacion = (int)Azar(7, 21);
+        
+        strcpy(grafo->cepas[i].Sintomas, "Fiebre, tos, fatiga");
+    }
+}
+
+//=============================================================
+//generacion de la red de contactos entre individuos
+//=============================================================
+
+//agrega un contacto bidireccional entre dos individuos
+void AgregarContacto(Individuo *ind1, Individuo *ind2, float prob){
+    if(ind1 == NULL || ind2 == NULL) return;
+    
+    Contacto *nuevo = (Contacto*)malloc(sizeof(Contacto));
+    nuevo->u_individuo = ind1->ID;
+    nuevo->v_individuo = ind2->ID;
+    nuevo->prob_contagio = prob;
+    nuevo->sgt = ind1->contactos;
+    ind1->contactos = nuevo;
+    
+    Contacto *nuevo2 = (Contacto*)malloc(sizeof(Contacto));
+    nuevo2->u_individuo = ind2->ID;
+    nuevo2->v_individuo = ind1->ID;
+    nuevo2->prob_contagio = prob;
+    nuevo2->sgt = ind2->contactos;
+    ind2->contactos = nuevo2;
+    
+    ind1->Grado++;
+    ind2->Grado++;
+}
+
+//quita el contacto id_otro de la lista de ind, retorna 1 si existia
+int QuitarDeLista(Individuo *ind, int id_otro){
+    Contacto *actual = ind->contactos;
+    Contacto *anterior = NULL;
+    
+    while(actual != NULL){
+        if(actual->v_individuo == id_otro){
+            if(anterior == NULL){
+                ind->contactos = actual->sgt;
+            } else {
+                anterior->sgt = actual->sgt;
+            }
+            free(actual);
+            ind->Grado--;
+            return 1;
+        }
+        anterior = actual;
+        actual = actual->sgt;
+    }
+    return 0;
+}
+
+//elimina el contacto bidireccional entre dos individuos
+void EliminarContacto(Individuo *ind1, Individuo *ind2){
+    if(ind1 == NULL || ind2 == NULL) return;
+    
+    QuitarDeLista(ind1, ind2->ID);
+    QuitarDeLista(ind2, ind1->ID);
+}
+
+//verifica si ya existe un contacto entre dos individuos
+int ExisteContacto(Individuo *ind, int id_otro){
+    if(ind == NULL) return 0;
+    
+    Contacto *actual = ind->contactos;
+    while(actual != NULL){
+        if(actual->v_individuo == id_otro) return 1;
+        actual = actual->sgt;
+    }
+    return 0;
+}
+
+void GenerarRedContactos(Mapa *grafo){
+    AsegurarCSR(grafo);
+    
+    for(int t = 0; t < NUM_TERRITORIOS; t++){
+        Territorio *territorio = &grafo->territorios[t];
+        
+        if(territorio->num_individuos == 0) continue;
+        
+        for(int i = 0; i < territorio->num_individuos; i++){
+            Individuo *ind1 = territorio->individuos[i];
+            if(ind1 == NULL) continue;
+            
+            int num_contactos = (int)Azar(2, ind1->Grado_inicial);
+            if(num_contactos > territorio->num_individuos - 1){
+                num_contactos = territorio->num_individuos - 1;
+            }
+            
+            int contactos_creados = 0;
+            
+            for(int intentos = 0; intentos < num_contactos * 3 && contactos_creados < num_contactos; intentos++){
+                int idx_aleatorio = (int)Azar(0, territorio->num_individuos);
+                
+                if(idx_aleatorio >= territorio->num_individuos) continue;
+                if(idx_aleatorio == i) continue;
+                
+                Individuo *ind2 = territorio->individuos[idx_aleatorio];
+                if(ind2 == NULL) continue;
+                
+                if(!ExisteContacto(ind1, ind2->ID)){
+                    float prob = Azar(0.1, 0.8);
                     AgregarContacto(ind1, ind2, prob);
                     contactos_creados++;
                 }
             }
         }
         
-        for(int t2 = t + 1; t2 < NUM_TERRITORIOS; t2++){
-            if(grafo->matrix[t][t2] > 0.0){
+        for(int e = grafo->csr_inicio[t]; e < grafo->csr_inicio[t + 1]; e++){
+            int t2 = grafo->csr_vecino[e];
+            if(t2 > t){
                 Territorio *territorio2 = &grafo->territorios[t2];
                 
                 if(territorio2->num_individuos == 0) continue;
@@ -1240,7 +2565,7 @@ void GenerarRedContactos(Mapa *grafo){
                     if(ind1 == NULL || ind2 == NULL) continue;
                     
                     if(!ExisteContacto(ind1, ind2->ID)){
-                        float prob = Azar(0.05, 0.3) * grafo->matrix[t][t2];
+                        float prob = Azar(0.05, 0.3) * grafo->csr_peso[e];
                         AgregarContacto(ind1, ind2, prob);
                     }
                 }
@@ -1308,9 +2633,11 @@ void IniciarBrote(Mapa *grafo, int territorio_inicial, int cepa_id, int num_infe
     for(int i = 0; i < territorio->num_individuos && infectados < num_infectados; i++){
         Individuo *ind = territorio->individuos[i];
         if(ind != NULL && !ind->Infectado){
-            ind->Infectado = 1;
+            float riesgo_antes = RiesgoIndividuo(ind);
+            MarcarInfectado(grafo, ind, 1);
             ind->t_infeccion = 0;
             ind->Cepa_ID = cepa_id;
+            ActualizarRiesgo(grafo, ind, riesgo_antes);
             infectados++;
         }
     }
@@ -1319,97 +2646,146 @@ void IniciarBrote(Mapa *grafo, int territorio_inicial, int cepa_id, int num_infe
 }
 
 //realiza bfs desde un territorio para encontrar territorios conectados con infectados
-void BFS_Brote(Mapa *grafo, int territorio_origen, int *visitados, int *cluster, int *tam_cluster){
-    Cola *cola = CrearCola(NUM_TERRITORIOS);
+//usa los contadores por territorio y el propio arreglo cluster como cola (sin reservar memoria)
+void BFS_Brote(Mapa *grafo, int territorio_origen, const int *infectados, int *visitados, int *cluster, int *tam_cluster){
+    AsegurarCSR(grafo);
     
+    int frente = *tam_cluster;
     visitados[territorio_origen] = 1;
-    cluster[*tam_cluster] = territorio_origen;
-    (*tam_cluster)++;
+    cluster[(*tam_cluster)++] = territorio_origen;
     
-    Encolar(cola, territorio_origen);
-    
-    while(!ColaVacia(cola)){
-        int t_actual = Desencolar(cola);
+    while(frente < *tam_cluster){
+        int t_actual = cluster[frente++];
         
-        for(int t = 0; t < NUM_TERRITORIOS; t++){
-            if(!visitados[t] && grafo->matrix[t_actual][t] > 0.0){
-                Territorio *terr = &grafo->territorios[t];
-                int tiene_infectados = 0;
-                
-                for(int i = 0; i < terr->num_individuos; i++){
-                    if(terr->individuos[i] != NULL && terr->individuos[i]->Infectado){
-                        tiene_infectados = 1;
-                        break;
-                    }
-                }
-                
-                if(tiene_infectados){
-                    visitados[t] = 1;
-                    cluster[*tam_cluster] = t;
-                    (*tam_cluster)++;
-                    Encolar(cola, t);
-                }
+        for(int e = grafo->csr_inicio[t_actual]; e < grafo->csr_inicio[t_actual + 1]; e++){
+            int t = grafo->csr_vecino[e];
+            if(!visitados[t] && infectados[t] > 0){
+                visitados[t] = 1;
+                cluster[(*tam_cluster)++] = t;
             }
         }
     }
-    
-    LiberarCola(cola);
 }
 
-//detecta y muestra todos los brotes activos usando bfs
+//detecta y muestra todos los brotes activos (clusters mantenidos incrementalmente)
 void DetectarBrotes(Mapa *grafo){
     printf("\n========== DETECCIÓN BFS ==========\n");
     
-    int visitados[NUM_TERRITORIOS] = {0};
-    int num_clusters = 0;
+    AsegurarBrotes(grafo);
     
-    for(int t = 0; t < NUM_TERRITORIOS; t++){
-        if(!visitados[t]){
-            Territorio *territorio = &grafo->territorios[t];
-            int tiene_infectados = 0;
-            
-            for(int i = 0; i < territorio->num_individuos; i++){
-                if(territorio->individuos[i] != NULL && territorio->individuos[i]->Infectado){
-                    tiene_infectados = 1;
-                    break;
-                }
-            }
-            
-            if(tiene_infectados){
-                int cluster[NUM_TERRITORIOS];
-                int tam_cluster = 0;
-                
-                BFS_Brote(grafo, t, visitados, cluster, &tam_cluster);
-                
-                num_clusters++;
-                printf("\n--- CLUSTER #%d ---\n", num_clusters);
-                printf("Territorios (%d):\n", tam_cluster);
-                
-                for(int i = 0; i < tam_cluster; i++){
-                    Territorio *terr = &grafo->territorios[cluster[i]];
-                    
-                    int infectados = 0;
-                    for(int j = 0; j < terr->num_individuos; j++){
-                        if(terr->individuos[j] != NULL && terr->individuos[j]->Infectado){
-                            infectados++;
-                        }
-                    }
-                    
-                    printf("  - %s: %d infectados\n", terr->Nombre, infectados);
-                }
-            }
+    for(int b = 0; b < grafo->num_brotes; b++){
+        int tam_cluster = grafo->brote_inicio[b + 1] - grafo->brote_inicio[b];
+        
+        printf("\n--- CLUSTER #%d ---\n", b + 1);
+        printf("Territorios (%d):\n", tam_cluster);
+        
+        for(int i = grafo->brote_inicio[b]; i < grafo->brote_inicio[b + 1]; i++){
+            int t = grafo->brote_miembros[i];
+            printf("  - %s: %d infectados\n", grafo->territorios[t].Nombre, grafo->infectados_territorio[t]);
         }
     }
     
-    if(num_clusters == 0){
+    if(grafo->num_brotes == 0){
         printf("\nNo hay brotes.\n");
     } else {
         printf("\n===================================\n");
-        printf("TOTAL CLUSTERS: %d\n", num_clusters);
+        printf("TOTAL CLUSTERS: %d\n", grafo->num_brotes);
         printf("===================================\n");
     }
 }
 
+//=============================================================
+//brotes incrementales - contadores por territorio y componentes bajo demanda
+//=============================================================
+
+//cambia el estado de infeccion de un individuo manteniendo el contador de su territorio
+//si el territorio pasa de limpio a infectado (o al reves) los clusters quedan obsoletos
+void MarcarInfectado(Mapa *grafo, Individuo *ind, int infectado){
+    infectado = infectado ? 1 : 0;
+    if(ind->Infectado == infectado) return;
+    
+    ind->Infectado = infectado;
+    int *contador = &grafo->infectados_territorio[ind->Territorio_ID];
+    *contador += infectado ? 1 : -1;
+    
+    if(*contador == 0 || (infectado && *contador == 1)){
+        grafo->brotes_validos = 0;
+    }
+}
+
+//agrupa los territorios con infectados en componentes conexas (bfs en orden del csr)
+//llena brote_de[], miembros[] e inicio[] y retorna el numero de clusters
+int CalcularComponentesBrotes(Mapa *grafo, const int *infectados, int *brote_de, int *miembros, int *inicio){
+    int visitados[NUM_TERRITORIOS] = {0};
+    int num_brotes = 0;
+    int total = 0;
+    
+    for(int t = 0; t < NUM_TERRITORIOS; t++){
+        brote_de[t] = -1;
+    }
+    
+    for(int t = 0; t < NUM_TERRITORIOS; t++){
+        if(visitados[t] || infectados[t] == 0) continue;
+        
+        int tam_cluster = 0;
+        inicio[num_brotes] = total;
+        BFS_Brote(grafo, t, infectados, visitados, miembros + total, &tam_cluster);
+        
+        for(int i = 0; i < tam_cluster; i++){
+            brote_de[miembros[total + i]] = num_brotes;
+        }
+        total += tam_cluster;
+        num_brotes++;
+    }
+    inicio[num_brotes] = total;
+    
+    return num_brotes;
+}
+
+//recalcula los clusters del mapa solo si algun territorio cambio de estado o de conexiones
+void AsegurarBrotes(Mapa *grafo){
+    if(grafo->brotes_validos) return;
+    
+    grafo->num_brotes = CalcularComponentesBrotes(grafo, grafo->infectados_territorio, grafo->brote_de,
+                                                  grafo->brote_miembros, grafo->brote_inicio);
+    grafo->brotes_validos = 1;
+}
+
+//cluster al que pertenece un territorio (-1 si esta limpio) - o(1) amortizado
+int BroteDeTerritorio(Mapa *grafo, int territorio){
+    AsegurarBrotes(grafo);
+    return grafo->brote_de[territorio];
+}
+
+//numero de clusters activos - o(1) amortizado
+int NumeroBrotes(Mapa *grafo){
+    AsegurarBrotes(grafo);
+    return grafo->num_brotes;
+}
+
+//guarda la foto de los clusters de un dia de la tabla dp
+//si ningun territorio cambio entre limpio e infectado se copia la del dia anterior
+void TomarSnapshotBrotes(TablaDP *dp, Mapa *grafo, int dia){
+    SnapshotBrotes *actual = &dp->brotes[dia];
+    
+    if(dia > 0){
+        SnapshotBrotes *anterior = &dp->brotes[dia - 1];
+        int cambio = 0;
+        for(int t = 0; t < NUM_TERRITORIOS && !cambio; t++){
+            cambio = (actual->infectados[t] > 0) != (anterior->infectados[t] > 0);
+        }
+        if(!cambio){
+            actual->num_brotes = anterior->num_brotes;
+            memcpy(actual->brote_de, anterior->brote_de, sizeof(actual->brote_de));
+            return;
+        }
+    }
+    
+    int miembros[NUM_TERRITORIOS];
+    int inicio[NUM_TERRITORIOS + 1];
+    actual->num_brotes = CalcularComponentesBrotes(grafo, actual->infectados, actual->brote_de, miembros, inicio);
+}
+
 void MostrarEstadisticasBrotes(Mapa *grafo){
     int total_infectados = 0;
     int total_recuperados = 0;
@@ -1443,12 +2819,7 @@ void MostrarEstadisticasBrotes(Mapa *grafo){
 int ContarInfectadosActivos(Mapa *grafo){
     int infectados = 0;
     for(int t = 0; t < NUM_TERRITORIOS; t++){
-        Territorio *territorio = &grafo->territorios[t];
-        for(int i = 0; i < territorio->num_individuos; i++){
-            if(territorio->individuos[i] != NULL && territorio->individuos[i]->Infectado){
-                infectados++;
-            }
-        }
+        infectados += grafo->infectados_territorio[t];
     }
     return infectados;
 }
@@ -1478,6 +2849,17 @@ TablaDP* CrearTablaDP(Mapa *grafo, int num_dias){
         }
     }
     
+    //indice inverso id -> posicion para resolver contactos en o(1)
+    dp->num_ids = IDs;
+    dp->indice_por_id = (int*)malloc((IDs > 0 ? IDs : 1) * sizeof(int));
+    for(int i = 0; i < IDs; i++){
+        dp->indice_por_id[i] = -1;
+    }
+    for(int i = 0; i < idx; i++){
+        int id = dp->individuos_lista[i]->ID;
+        if(id >= 0 && id < IDs) dp->indice_por_id[id] = i;
+    }
+    
     //crear tabla 2D [dias][individuos] - memoizacion
     dp->tabla = (EstadoDP**)malloc(dp->num_dias * sizeof(EstadoDP*));
     for(int d = 0; d < dp->num_dias; d++){
@@ -1489,6 +2871,12 @@ TablaDP* CrearTablaDP(Mapa *grafo, int num_dias){
         }
     }
     
+    dp->brotes = (SnapshotBrotes*)calloc(dp->num_dias, sizeof(SnapshotBrotes));
+    dp->red = ConstruirRedContactos(grafo);
+    dp->uf_cadenas = CrearUnionFind(dp->red->n);
+    dp->infectado_id = (unsigned char*)calloc(dp->red->n, sizeof(unsigned char));
+    dp->tamanio_cadena = (int*)malloc(dp->red->n * sizeof(int));
+    
     return dp;
 }
 
@@ -1499,6 +2887,12 @@ void LiberarTablaDP(TablaDP *dp){
     }
     free(dp->tabla);
     free(dp->individuos_lista);
+    free(dp->indice_por_id);
+    free(dp->brotes);
+    LiberarRedContactos(dp->red);
+    LiberarUnionFind(dp->uf_cadenas);
+    free(dp->infectado_id);
+    free(dp->tamanio_cadena);
     free(dp);
 }
 
@@ -1516,16 +2910,16 @@ void InicializarDia0(TablaDP *dp, Mapa *grafo){
             dp->tabla[0][i].estado = ESTADO_FALLECIDO;
         }
     }
+    
+    memcpy(dp->brotes[0].infectados, grafo->infectados_territorio, sizeof(dp->brotes[0].infectados));
+    TomarSnapshotBrotes(dp, grafo, 0);
+    TomarSnapshotCadenas(dp, 0);
 }
 
-//buscar indice de un individuo por su ID
+//buscar indice de un individuo por su ID - o(1) con el indice inverso
 int BuscarIndiceIndividuo(TablaDP *dp, int id){
-    for(int i = 0; i < dp->num_individuos; i++){
-        if(dp->individuos_lista[i]->ID == id){
-            return i;
-        }
-    }
-    return -1;
+    if(id < 0 || id >= dp->num_ids) return -1;
+    return dp->indice_por_id[id];
 }
 
 //funcion de transicion dp: estado[d] = f(estado[d-1])
@@ -1541,6 +2935,10 @@ void TransicionDP(TablaDP *dp, Mapa *grafo, int dia){
         }
     }
     
+    //los contadores por territorio parten del dia anterior y se ajustan en cada transicion
+    int *infectados_terr = dp->brotes[dia].infectados;
+    memcpy(infectados_terr, dp->brotes[dia-1].infectados, sizeof(dp->brotes[dia].infectados));
+    
     //paso 2: procesar recuperaciones y fallecimientos
     for(int i = 0; i < dp->num_individuos; i++){
         EstadoDP *estado = &dp->tabla[dia][i];
@@ -1551,11 +2949,13 @@ void TransicionDP(TablaDP *dp, Mapa *grafo, int dia){
             //recuperacion si paso suficiente tiempo
             if(estado->dia_infeccion >= cepa->Tiempo_recuperacion){
                 estado->estado = ESTADO_RECUPERADO;
+                infectados_terr[dp->individuos_lista[i]->Territorio_ID]--;
             }
             //posible muerte despues de incubacion
             else if(estado->dia_infeccion > cepa->Tiempo_incubacion){
                 if(Azar(0.0, 1.0) < cepa->Tasa_mortalidad * 0.02){
                     estado->estado = ESTADO_FALLECIDO;
+                    infectados_terr[dp->individuos_lista[i]->Territorio_ID]--;
                 }
             }
         }
@@ -1584,11 +2984,16 @@ void TransicionDP(TablaDP *dp, Mapa *grafo, int dia){
                     dp->tabla[dia][idx_contacto].estado = ESTADO_INFECTADO;
                     dp->tabla[dia][idx_contacto].dia_infeccion = 0;
                     dp->tabla[dia][idx_contacto].cepa_id = cepa_id;
+                    infectados_terr[dp->individuos_lista[idx_contacto]->Territorio_ID]++;
                 }
             }
             c = c->sgt;
         }
     }
+    
+    //paso 4: clusters del dia (solo se recalculan si algun territorio cambio de estado)
+    TomarSnapshotBrotes(dp, grafo, dia);
+    TomarSnapshotCadenas(dp, dia);
 }
 
 //contar estados en un dia especifico de la tabla dp
@@ -1608,17 +3013,19 @@ void ContarEstadosDia(TablaDP *dp, int dia, int *sanos, int *infectados, int *re
 void MostrarEstadoDiaDP(TablaDP *dp, int dia){
     int sanos, infectados, recuperados, fallecidos;
     ContarEstadosDia(dp, dia, &sanos, &infectados, &recuperados, &fallecidos);
-    printf("[Día %3d] Sanos: %4d | Infectados: %4d | Recuperados: %4d | Fallecidos: %4d\n", 
-           dia, sanos, infectados, recuperados, fallecidos);
+    printf("[Día %3d] Sanos: %4d | Infectados: %4d | Recuperados: %4d | Fallecidos: %4d | Brotes: %2d | Cadenas: %3d (max %3d)\n", 
+           dia, sanos, infectados, recuperados, fallecidos, dp->brotes[dia].num_brotes,
+           dp->brotes[dia].cadenas, dp->brotes[dia].mayor_cadena);
 }
 
 //sincronizar tabla dp con estructuras de individuos al final
-void SincronizarEstados(TablaDP *dp, int dia_final){
+void SincronizarEstados(TablaDP *dp, Mapa *grafo, int dia_final){
     for(int i = 0; i < dp->num_individuos; i++){
         Individuo *ind = dp->individuos_lista[i];
         EstadoDP *estado = &dp->tabla[dia_final][i];
+        float riesgo_antes = RiesgoIndividuo(ind);
         
-        ind->Infectado = (estado->estado == ESTADO_INFECTADO) ? 1 : 0;
+        MarcarInfectado(grafo, ind, estado->estado == ESTADO_INFECTADO);
         ind->Recuperado = (estado->estado == ESTADO_RECUPERADO) ? 1 : 0;
         ind->Fallecido = (estado->estado == ESTADO_FALLECIDO) ? 1 : 0;
         ind->t_infeccion = estado->dia_infeccion;
@@ -1627,6 +3034,8 @@ void SincronizarEstados(TablaDP *dp, int dia_final){
         if(ind->Recuperado){
             ind->Riesgo_inicial = 0.0;
         }
+        
+        ActualizarRiesgo(grafo, ind, riesgo_antes);
     }
 }
 
@@ -1708,7 +3117,7 @@ void SimularPropagacion(Mapa *grafo, int num_dias){
     }
     
     //sincronizar estados finales con estructuras originales
-    SincronizarEstados(dp, dia_final);
+    SincronizarEstados(dp, grafo, dia_final);
     
     //generar reporte
     GenerarReportePropagacion(dp, grafo, dia_final);
@@ -1724,32 +3133,47 @@ void SimularPropagacion(Mapa *grafo, int num_dias){
 }
 
 //=============================================================
-//minimizacion de riesgo con algoritmo greedy - o(n log n)
+//minimizacion de riesgo con algoritmo greedy - o(n + k log k)
 //=============================================================
 
-//calcula el riesgo total sumando riesgos de todos los individuos
-float CalcularRiesgoTotal(Mapa *grafo){
-    float riesgo_total = 0.0;
+//aporte de un individuo al riesgo total (0 si esta infectado o recuperado)
+float RiesgoIndividuo(Individuo *ind){
+    if(ind == NULL || ind->Infectado || ind->Recuperado) return 0.0;
+    return ind->Riesgo_inicial * (1.0 + ind->Grado * 0.1);
+}
+
+//reconstruye el acumulador de riesgo recorriendo a todos los individuos - o(n)
+//se llama una vez con la red de contactos ya construida
+void RecalcularRiesgoTotal(Mapa *grafo){
+    grafo->riesgo_total = 0.0;
     
     for(int t = 0; t < NUM_TERRITORIOS; t++){
         Territorio *territorio = &grafo->territorios[t];
+        double riesgo = 0.0;
         for(int i = 0; i < territorio->num_individuos; i++){
-            Individuo *ind = territorio->individuos[i];
-            if(ind != NULL && !ind->Infectado && !ind->Recuperado){
-                int num_contactos = 0;
-                Contacto *c = ind->contactos;
-                while(c != NULL){
-                    num_contactos++;
-                    c = c->sgt;
-                }
-                
-                float riesgo = ind->Riesgo_inicial * (1.0 + num_contactos * 0.1);
-                riesgo_total += riesgo;
-            }
+            riesgo += RiesgoIndividuo(territorio->individuos[i]);
         }
+        grafo->riesgo_territorio[t] = riesgo;
+        grafo->riesgo_total += riesgo;
     }
-    
-    return riesgo_total;
+}
+
+//aplica al acumulador la diferencia entre el riesgo anterior y el actual
+void ActualizarRiesgo(Mapa *grafo, Individuo *ind, float riesgo_antes){
+    double delta = RiesgoIndividuo(ind) - riesgo_antes;
+    grafo->riesgo_total += delta;
+    grafo->riesgo_territorio[ind->Territorio_ID] += delta;
+}
+
+//retorna el riesgo total desde el acumulador - o(1)
+float CalcularRiesgoTotal(Mapa *grafo){
+    return (float)grafo->riesgo_total;
+}
+
+//retorna el riesgo acumulado de un territorio - o(1)
+float CalcularRiesgoTerritorio(Mapa *grafo, int territorio_id){
+    if(territorio_id < 0 || territorio_id >= NUM_TERRITORIOS) return 0.0;
+    return (float)grafo->riesgo_territorio[territorio_id];
 }
 
 void CalcularRiesgoIndividuos(Mapa *grafo, IndividuoRiesgo **lista_riesgo, int *total){
@@ -1773,15 +3197,8 @@ void CalcularRiesgoIndividuos(Mapa *grafo, IndividuoRiesgo **lista_riesgo, int *
         for(int i = 0; i < territorio->num_individuos; i++){
             Individuo *ind = territorio->individuos[i];
             if(ind != NULL && !ind->Infectado && !ind->Recuperado && !ind->Fallecido){
-                int num_contactos = 0;
-                Contacto *c = ind->contactos;
-                while(c != NULL){
-                    num_contactos++;
-                    c = c->sgt;
-                }
-                
                 float riesgo = ind->Riesgo_inicial * 0.3;
-                riesgo += (num_contactos * 0.05);
+                riesgo += (ind->Grado * 0.05);
                 
                 (*lista_riesgo)[idx].individuo = ind;
                 (*lista_riesgo)[idx].riesgo_calculado = riesgo;
@@ -1801,9 +3218,11 @@ int CompararRiesgo(const void *a, const void *b){
 }
 
 //marca un individuo como vacunado reduciendo su riesgo a cero
-void VacunarIndividuo(Individuo *ind){
+void VacunarIndividuo(Mapa *grafo, Individuo *ind){
+    float riesgo_antes = RiesgoIndividuo(ind);
     ind->Recuperado = 1;
     ind->Riesgo_inicial = 0.0;
+    ActualizarRiesgo(grafo, ind, riesgo_antes);
 }
 
 //selecciona individuos para vacunar usando algoritmo greedy
@@ -1825,8 +3244,9 @@ void MinimizarRiesgoGreedy(Mapa *grafo, int num_vacunas){
     printf("Total sanos: %d\n", total_individuos);
     printf("Vacunas: %d\n", num_vacunas);
     
-    //ordenar por riesgo usando quicksort propio
-    QuickSortRiesgo(lista_riesgo, 0, total_individuos - 1);
+    //solo se necesitan los k de mayor riesgo: seleccion o(n) + orden o(k log k)
+    int k = (num_vacunas > 10) ? num_vacunas : 10;
+    SeleccionarTopKRiesgo(lista_riesgo, total_individuos, k);
     
     printf("\nTop 10 mayor riesgo:\n");
     for(int i = 0; i < 10 && i < total_individuos; i++){
@@ -1839,7 +3259,7 @@ void MinimizarRiesgoGreedy(Mapa *grafo, int num_vacunas){
     
     printf("\nVacunando %d individuos...\n", num_vacunas);
     for(int i = 0; i < num_vacunas; i++){
-        VacunarIndividuo(lista_riesgo[i].individuo);
+        VacunarIndividuo(grafo, lista_riesgo[i].individuo);
     }
     
     float riesgo_final = CalcularRiesgoTotal(grafo);
@@ -1854,6 +3274,300 @@ void MinimizarRiesgoGreedy(Mapa *grafo, int num_vacunas){
     free(lista_riesgo);
 }
 
+//=============================================================
+//vacunacion greedy perezosa (celf) con simulaciones monte carlo
+//=============================================================
+
+//devuelve el tiempo actual en segundos (reloj monotono)
+double TiempoActual(){
+#ifdef _OPENMP
+    return omp_get_wtime();
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+    return (double)clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+//indice del hilo actual (0 sin openmp)
+int HiloActual(){
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+}
+
+//moneda determinista para la arista u->v en la simulacion sim
+//misma moneda en todas las evaluaciones (numeros aleatorios comunes)
+float MonedaArista(unsigned int semilla, int sim, int u, int v){
+    unsigned long long x = ((unsigned long long)(unsigned int)u << 32) ^ (unsigned int)v;
+    x ^= (unsigned long long)semilla * 0x9E3779B97F4A7C15ULL + (unsigned long long)sim * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return (float)(x >> 40) / (float)(1 << 24);
+}
+
+//prepara el contexto: individuos por id, bloqueados, semillas y workspace por hilo
+ContextoCELF* CrearContextoCELF(Mapa *grafo, int num_simulaciones){
+    ContextoCELF *ctx = (ContextoCELF*)malloc(sizeof(ContextoCELF));
+    ctx->grafo = grafo;
+    ctx->n = IDs;
+    ctx->num_simulaciones = num_simulaciones;
+    ctx->semilla = 12345;
+    ctx->por_id = (Individuo**)calloc(ctx->n, sizeof(Individuo*));
+    ctx->bloqueado = (unsigned char*)calloc(ctx->n, sizeof(unsigned char));
+    ctx->semillas = (int*)malloc(ctx->n * sizeof(int));
+    ctx->num_semillas = 0;
+    
+    for(int v = 0; v < ctx->n; v++){
+        Individuo *ind = IndividuoPorID(grafo, v);
+        if(ind == NULL) continue;
+        
+        ctx->por_id[v] = ind;
+        if(ind->Recuperado || ind->Fallecido){
+            ctx->bloqueado[v] = 1;
+        } else if(ind->Infectado){
+            ctx->semillas[ctx->num_semillas++] = v;
+        }
+    }
+    
+#ifdef _OPENMP
+    ctx->num_hilos = omp_get_max_threads();
+#else
+    ctx->num_hilos = 1;
+#endif
+    ctx->marca = (int**)malloc(ctx->num_hilos * sizeof(int*));
+    ctx->cola = (int**)malloc(ctx->num_hilos * sizeof(int*));
+    ctx->cepa = (int**)malloc(ctx->num_hilos * sizeof(int*));
+    ctx->sello = (int*)calloc(ctx->num_hilos, sizeof(int));
+    for(int h = 0; h < ctx->num_hilos; h++){
+        ctx->marca[h] = (int*)calloc(ctx->n, sizeof(int));
+        ctx->cola[h] = (int*)malloc(ctx->n * sizeof(int));
+        ctx->cepa[h] = (int*)malloc(ctx->n * sizeof(int));
+    }
+    
+    return ctx;
+}
+
+//libera el contexto de celf
+void LiberarContextoCELF(ContextoCELF *ctx){
+    for(int h = 0; h < ctx->num_hilos; h++){
+        free(ctx->marca[h]);
+        free(ctx->cola[h]);
+        free(ctx->cepa[h]);
+    }
+    free(ctx->marca);
+    free(ctx->cola);
+    free(ctx->cepa);
+    free(ctx->sello);
+    free(ctx->por_id);
+    free(ctx->bloqueado);
+    free(ctx->semillas);
+    free(ctx);
+}
+
+//simula una cascada independiente desde los infectados actuales
+//el individuo extra (si es >= 0) se trata como vacunado; retorna infectados alcanzados
+int SimularCascada(ContextoCELF *ctx, int extra, int sim, int hilo){
+    int *marca = ctx->marca[hilo];
+    int *cola = ctx->cola[hilo];
+    int *cepa = ctx->cepa[hilo];
+    int sello = ++ctx->sello[hilo];
+    int frente = 0, final = 0;
+    
+    for(int s = 0; s < ctx->num_semillas; s++){
+        int id = ctx->semillas[s];
+        int cepa_id = ctx->por_id[id]->Cepa_ID;
+        marca[id] = sello;
+        cepa[id] = (cepa_id >= 0 && cepa_id < NUM_CEPAS) ? cepa_id : 0;
+        cola[final++] = id;
+    }
+    
+    while(frente < final){
+        int u = cola[frente++];
+        Cepa *cp = &ctx->grafo->cepas[cepa[u]];
+        
+        Contacto *c = ctx->por_id[u]->contactos;
+        while(c != NULL){
+            int v = c->v_individuo;
+            if(marca[v] != sello && !ctx->bloqueado[v] && v != extra){
+                //probabilidad diaria del modelo dp acumulada durante la infeccion
+                float q = c->prob_contagio * 0.15 * cp->Tasa_contagio;
+                float p = 1.0 - powf(1.0 - q, (float)cp->Tiempo_recuperacion);
+                
+                if(MonedaArista(ctx->semilla, sim, u, v) < p){
+                    marca[v] = sello;
+                    cepa[v] = cepa[u];
+                    cola[final++] = v;
+                }
+            }
+            c = c->sgt;
+        }
+    }
+    
+    return final;
+}
+
+//estima el numero esperado de infectados promediando las simulaciones
+double EstimarPropagacion(ContextoCELF *ctx, int extra, int paralelo){
+    double total = 0.0;
+    
+    if(paralelo){
+        #pragma omp parallel for reduction(+:total) schedule(dynamic, 4)
+        for(int sim = 0; sim < ctx->num_simulaciones; sim++){
+            total += SimularCascada(ctx, extra, sim, HiloActual());
+        }
+    } else {
+        for(int sim = 0; sim < ctx->num_simulaciones; sim++){
+            total += SimularCascada(ctx, extra, sim, HiloActual());
+        }
+    }
+    
+    return total / ctx->num_simulaciones;
+}
+
+//selecciona vacunados minimizando la propagacion esperada con celf
+//los candidatos se toman de los mejores por heuristica para acotar el costo
+void MinimizarRiesgoCELF(Mapa *grafo, int num_vacunas, int num_simulaciones){
+    printf("\n========== GREEDY PEREZOSO (CELF) ==========\n");
+    printf("Ganancia marginal estimada con %d simulaciones Monte Carlo\n", num_simulaciones);
+    
+    ContextoCELF *ctx = CrearContextoCELF(grafo, num_simulaciones);
+    
+    if(ctx->num_semillas == 0){
+        printf("\nNo hay infectados activos: la propagacion esperada es 0.\n");
+        printf("Use el modo heuristico o inicie un brote en Fase 2.\n");
+        LiberarContextoCELF(ctx);
+        return;
+    }
+    
+    IndividuoRiesgo *lista_riesgo;
+    int total_individuos;
+    CalcularRiesgoIndividuos(grafo, &lista_riesgo, &total_individuos);
+    
+    if(num_vacunas > total_individuos){
+        num_vacunas = total_individuos;
+    }
+    if(num_vacunas <= 0){
+        printf("No hay individuos para vacunar.\n");
+        free(lista_riesgo);
+        LiberarContextoCELF(ctx);
+        return;
+    }
+    
+    //pool de candidatos: los mejores por heuristica (los primeros k son la solucion heuristica)
+    int num_candidatos = num_vacunas * 4;
+    if(num_candidatos < 200) num_candidatos = 200;
+    if(num_candidatos > total_individuos) num_candidatos = total_individuos;
+    SeleccionarTopKRiesgo(lista_riesgo, total_individuos, num_candidatos);
+    
+    printf("Infectados activos: %d\n", ctx->num_semillas);
+    printf("Candidatos evaluados: %d de %d sanos\n", num_candidatos, total_individuos);
+    printf("Vacunas: %d\n", num_vacunas);
+    
+    double base_sin_vacunas = EstimarPropagacion(ctx, -1, 1);
+    
+    //solucion heuristica actual para comparar
+    double t_inicio = TiempoActual();
+    for(int i = 0; i < num_vacunas; i++){
+        ctx->bloqueado[lista_riesgo[i].individuo->ID] = 1;
+    }
+    double esperado_heuristica = EstimarPropagacion(ctx, -1, 1);
+    for(int i = 0; i < num_vacunas; i++){
+        ctx->bloqueado[lista_riesgo[i].individuo->ID] = 0;
+    }
+    double t_heuristica = TiempoActual() - t_inicio;
+    
+    //celf: evaluacion inicial de todos los candidatos en paralelo
+    t_inicio = TiempoActual();
+    float *ganancia = (float*)malloc(num_candidatos * sizeof(float));
+    int *ronda = (int*)malloc(num_candidatos * sizeof(int));
+    int *elegidos = (int*)malloc(num_vacunas * sizeof(int));
+    
+    #pragma omp parallel for schedule(dynamic, 1)
+    for(int c = 0; c < num_candidatos; c++){
+        int id = lista_riesgo[c].individuo->ID;
+        ganancia[c] = (float)(base_sin_vacunas - EstimarPropagacion(ctx, id, 0));
+        ronda[c] = 0;
+    }
+    int evaluaciones = num_candidatos;
+    
+    //cola de prioridad con el minheap existente (prioridad = -ganancia)
+    MinHeap *heap = CrearMinHeap(num_candidatos);
+    for(int c = 0; c < num_candidatos; c++){
+        InsertarHeap(heap, c, -ganancia[c]);
+    }
+    
+    double base_actual = base_sin_vacunas;
+    int num_elegidos = 0;
+    
+    while(num_elegidos < num_vacunas && !EstaVacio(heap)){
+        NodoHeap tope = ExtraerMin(heap);
+        int c = tope.vertice;
+        int id = lista_riesgo[c].individuo->ID;
+        
+        if(ronda[c] == num_elegidos){
+            //ganancia vigente: por submodularidad ningun otro candidato la supera
+            elegidos[num_elegidos++] = c;
+            ctx->bloqueado[id] = 1;
+            base_actual -= ganancia[c];
+        } else {
+            //ganancia obsoleta: reevaluar solo este candidato (lazy)
+            ganancia[c] = (float)(base_actual - EstimarPropagacion(ctx, id, 1));
+            ronda[c] = num_elegidos;
+            evaluaciones++;
+            InsertarHeap(heap, c, -ganancia[c]);
+        }
+    }
+    
+    double esperado_celf = EstimarPropagacion(ctx, -1, 1);
+    double t_celf = TiempoActual() - t_inicio;
+    
+    printf("\nTop 10 elegidos por CELF:\n");
+    for(int i = 0; i < 10 && i < num_elegidos; i++){
+        Individuo *ind = lista_riesgo[elegidos[i]].individuo;
+        printf("%2d. %s (%s) - ganancia %.3f\n",
+               i+1,
+               ind->Nombre,
+               grafo->territorios[ind->Territorio_ID].Nombre,
+               ganancia[elegidos[i]]);
+    }
+    
+    float riesgo_inicial = CalcularRiesgoTotal(grafo);
+    for(int i = 0; i < num_elegidos; i++){
+        VacunarIndividuo(grafo, lista_riesgo[elegidos[i]].individuo);
+    }
+    float riesgo_final = CalcularRiesgoTotal(grafo);
+    
+    printf("\n--- Comparacion (infectados esperados) ---\n");
+    printf("%-22s %12s %12s\n", "Metodo", "Esperados", "Tiempo (s)");
+    printf("-------------------------------------------------\n");
+    printf("%-22s %12.2f %12s\n", "Sin vacunar", base_sin_vacunas, "-");
+    printf("%-22s %12.2f %12.4f\n", "Heuristica", esperado_heuristica, t_heuristica);
+    printf("%-22s %12.2f %12.4f\n", "CELF", esperado_celf, t_celf);
+    printf("Evaluaciones CELF: %d (greedy ingenuo: %d)\n",
+           evaluaciones, num_candidatos * num_elegidos);
+    
+    printf("\n===============================\n");
+    printf("Riesgo inicial: %.2f\n", riesgo_inicial);
+    printf("Riesgo final:   %.2f\n", riesgo_final);
+    if(riesgo_inicial > 0){
+        printf("Reducción:      %.2f%%\n", (riesgo_inicial - riesgo_final) / riesgo_inicial * 100.0);
+    }
+    printf("===============================\n");
+    
+    LiberarHeap(heap);
+    free(ganancia);
+    free(ronda);
+    free(elegidos);
+    free(lista_riesgo);
+    LiberarContextoCELF(ctx);
+}
+
 //=============================================================
 //arbol de expansion minima con prim - o((n+m) log n)
 //=============================================================
@@ -1861,7 +3575,7 @@ void MinimizarRiesgoGreedy(Mapa *grafo, int num_vacunas){
 float CalcularPesoTotalMST(Mapa *grafo, int *padre){
     float peso_total = 0.0;
     
-    for(int v = 1; v < NUM_TERRITORIOS; v++){
+    for(int v = 0; v < NUM_TERRITORIOS; v++){
         if(padre[v] != -1){
             peso_total += grafo->matrix[padre[v]][v];
         }
@@ -1904,177 +3618,725 @@ void AlgoritmoPrim(Mapa *grafo, int territorio_inicio){
     
     int *padre = (int*)malloc(NUM_TERRITORIOS * sizeof(int));
     float *clave = (float*)malloc(NUM_TERRITORIOS * sizeof(float));
-    int *en_mst = (int*)malloc(NUM_TERRITORIOS * sizeof(int));
-    
-    for(int i = 0; i < NUM_TERRITORIOS; i++){
-        padre[i] = -1;
-        clave[i] = 999999.0;
-        en_mst[i] = 0;
-    }
-    
-    clave[territorio_inicio] = 0.0;
-    
-    MinHeap *heap = CrearMinHeap(NUM_TERRITORIOS);
-    
-    for(int v = 0; v < NUM_TERRITORIOS; v++){
-        InsertarHeap(heap, v, clave[v]);
-    }
-    
-    int vertices_procesados = 0;
-    
-    while(!EstaVacio(heap) && vertices_procesados < NUM_TERRITORIOS){
-        NodoHeap min_nodo = ExtraerMin(heap);
-        int u = min_nodo.vertice;
-        
-        if(u == -1) break;
-        
-        en_mst[u] = 1;
-        vertices_procesados++;
-        
-        for(int v = 0; v < NUM_TERRITORIOS; v++){
-            if(grafo->matrix[u][v] > 0.0 && !en_mst[v]){
-                float prioridad = 1.0 - grafo->matrix[u][v];
-                
-                if(prioridad < clave[v]){
-                    padre[v] = u;
-                    clave[v] = prioridad;
-                    DisminuirClave(heap, v, prioridad);
-                }
-            }
-        }
-    }
     
+    CalcularPrim(grafo, territorio_inicio, padre, clave);
     MostrarMST(grafo, padre, clave);
     
-    LiberarHeap(heap);
     free(padre);
     free(clave);
-    free(en_mst);
+}
+
+//calcula el arbol de prim sin imprimir (llena padre y clave)
+void CalcularPrim(Mapa *grafo, int territorio_inicio, int *padre, float *clave){
+    AsegurarCSR(grafo);
+    
+    TipoCola tipo = ElegirColaPorTamanio(NUM_TERRITORIOS);
+    if(tipo == COLA_RADIX) tipo = COLA_CUATERNARIA;
+    ColaPrioridad *cola = CrearColaPrioridad(tipo, NUM_TERRITORIOS);
+    
+    PrimCSR(NUM_TERRITORIOS, grafo->csr_inicio, grafo->csr_vecino, grafo->csr_peso,
+            territorio_inicio, clave, padre, cola);
+    
+    LiberarColaPrioridad(cola);
 }
 
 //=============================================================
-//tabla hash para busqueda de individuos en o(1)
+//union-find con compresion de caminos y union por rango - o(alfa(n))
 //=============================================================
 
-//crea una nueva tabla hash vacia para individuos
-HashTable* CrearHashTable(){
-    HashTable *tabla = (HashTable*)malloc(sizeof(HashTable));
-    tabla->num_elementos = 0;
+//crea una estructura union-find con n conjuntos individuales
+UnionFind* CrearUnionFind(int n){
+    UnionFind *uf = (UnionFind*)malloc(sizeof(UnionFind));
+    uf->n = n;
+    uf->padre = (int*)malloc(n * sizeof(int));
+    uf->rango = (int*)calloc(n, sizeof(int));
     
-    for(int i = 0; i < HASH_SIZE; i++){
-        tabla->tabla[i] = NULL;
+    for(int i = 0; i < n; i++){
+        uf->padre[i] = i;
     }
     
-    return tabla;
+    return uf;
 }
 
-//calcula el indice hash para un id dado
-int FuncionHash(int id){
-    return id % HASH_SIZE;
+//encuentra el representante de x comprimiendo el camino (por mitades)
+int EncontrarUF(UnionFind *uf, int x){
+    while(uf->padre[x] != x){
+        uf->padre[x] = uf->padre[uf->padre[x]];
+        x = uf->padre[x];
+    }
+    return x;
 }
 
-//inserta un individuo en la tabla hash
-void InsertarHash(HashTable *tabla, Individuo *individuo){
-    if(individuo == NULL) return;
-    
-    int indice = FuncionHash(individuo->ID);
+//une los conjuntos de a y b por rango, retorna 1 si estaban separados
+int UnirUF(UnionFind *uf, int a, int b){
+    int ra = EncontrarUF(uf, a);
+    int rb = EncontrarUF(uf, b);
     
-    NodoHash *nuevo = (NodoHash*)malloc(sizeof(NodoHash));
-    nuevo->ID = individuo->ID;
-    nuevo->individuo = individuo;
-    nuevo->siguiente = tabla->tabla[indice];
+    if(ra == rb) return 0;
     
-    tabla->tabla[indice] = nuevo;
-    tabla->num_elementos++;
+    if(uf->rango[ra] < uf->rango[rb]){
+        int temp = ra;
+        ra = rb;
+        rb = temp;
+    }
+    uf->padre[rb] = ra;
+    if(uf->rango[ra] == uf->rango[rb]){
+        uf->rango[ra]++;
+    }
+    return 1;
 }
 
-//busca un individuo por id en la tabla hash - o(1)
-Individuo* BuscarHash(HashTable *tabla, int id){
-    int indice = FuncionHash(id);
-    
-    NodoHash *actual = tabla->tabla[indice];
+//libera la memoria del union-find
+void LiberarUnionFind(UnionFind *uf){
+    free(uf->padre);
+    free(uf->rango);
+    free(uf);
+}
+
+//=============================================================
+//bosque de expansion minima con kruskal y boruvka - o(e alfa(v))
+//=============================================================
+
+//convierte un float en una llave entera que conserva el orden (para radix sort)
+unsigned int LlaveOrdenFloat(float f){
+    unsigned int bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return (bits & 0x80000000u) ? ~bits : (bits | 0x80000000u);
+}
+
+//ordena indices de aristas por llave ascendente con radix sort lsd (4 pasadas de 8 bits)
+void RadixSortAristas(unsigned int *llaves, int *indices, int n){
+    unsigned int *llaves_aux = (unsigned int*)malloc(n * sizeof(unsigned int));
+    int *indices_aux = (int*)malloc(n * sizeof(int));
     
-    while(actual != NULL){
-        if(actual->ID == id){
-            return actual->individuo;
+    for(int desplazamiento = 0; desplazamiento < 32; desplazamiento += 8){
+        int conteo[257] = {0};
+        
+        for(int i = 0; i < n; i++){
+            conteo[((llaves[i] >> desplazamiento) & 0xFF) + 1]++;
         }
-        actual = actual->siguiente;
+        for(int b = 0; b < 256; b++){
+            conteo[b + 1] += conteo[b];
+        }
+        for(int i = 0; i < n; i++){
+            int destino = conteo[(llaves[i] >> desplazamiento) & 0xFF]++;
+            llaves_aux[destino] = llaves[i];
+            indices_aux[destino] = indices[i];
+        }
+        
+        memcpy(llaves, llaves_aux, n * sizeof(unsigned int));
+        memcpy(indices, indices_aux, n * sizeof(int));
     }
     
-    return NULL;
+    free(llaves_aux);
+    free(indices_aux);
 }
 
-void EliminarHash(HashTable *tabla, int id){
-    int indice = FuncionHash(id);
-    
-    NodoHash *actual = tabla->tabla[indice];
-    NodoHash *anterior = NULL;
+//kruskal: recorre aristas ordenadas por 1 - proximidad (igual criterio que prim)
+//si el grafo es disconexo produce un bosque; retorna el numero de aristas
+int CalcularKruskal(Mapa *grafo, AristaMST *aristas){
+    int m = grafo->num_conexiones;
+    unsigned int *llaves = (unsigned int*)malloc((m > 0 ? m : 1) * sizeof(unsigned int));
+    int *indices = (int*)malloc((m > 0 ? m : 1) * sizeof(int));
+    
+    for(int e = 0; e < m; e++){
+        llaves[e] = LlaveOrdenFloat(1.0 - grafo->conexiones[e].peso_proximidad);
+        indices[e] = e;
+    }
+    RadixSortAristas(llaves, indices, m);
+    
+    UnionFind *uf = CrearUnionFind(NUM_TERRITORIOS);
+    int num_aristas = 0;
+    
+    for(int i = 0; i < m && num_aristas < NUM_TERRITORIOS - 1; i++){
+        ConexionTerritorio *c = &grafo->conexiones[indices[i]];
+        if(UnirUF(uf, c->u_territorio, c->v_territorio)){
+            aristas[num_aristas].territorio_u = c->u_territorio;
+            aristas[num_aristas].territorio_v = c->v_territorio;
+            aristas[num_aristas].peso = c->peso_proximidad;
+            num_aristas++;
+        }
+    }
     
-    while(actual != NULL){
-        if(actual->ID == id){
-            if(anterior == NULL){
-                tabla->tabla[indice] = actual->siguiente;
-            } else {
-                anterior->siguiente = actual->siguiente;
+    LiberarUnionFind(uf);
+    free(llaves);
+    free(indices);
+    return num_aristas;
+}
+
+//indica si la arista a es mas barata que b (desempate por indice)
+int AristaMasBarata(Mapa *grafo, int a, int b){
+    if(b == -1) return 1;
+    float pa = 1.0 - grafo->conexiones[a].peso_proximidad;
+    float pb = 1.0 - grafo->conexiones[b].peso_proximidad;
+    return (pa < pb) || (pa == pb && a < b);
+}
+
+//boruvka: en cada ronda cada componente elige su arista mas barata hacia afuera
+//la busqueda de aristas se reparte entre hilos; retorna el numero de aristas
+int CalcularBoruvka(Mapa *grafo, AristaMST *aristas){
+    int m = grafo->num_conexiones;
+    UnionFind *uf = CrearUnionFind(NUM_TERRITORIOS);
+    int *mejor = (int*)malloc(NUM_TERRITORIOS * sizeof(int));
+    int *componente = (int*)malloc(NUM_TERRITORIOS * sizeof(int));
+    int num_aristas = 0;
+    int hubo_union = 1;
+    
+    while(hubo_union && num_aristas < NUM_TERRITORIOS - 1){
+        hubo_union = 0;
+        
+        for(int v = 0; v < NUM_TERRITORIOS; v++){
+            componente[v] = EncontrarUF(uf, v);
+            mejor[v] = -1;
+        }
+        
+        #pragma omp parallel
+        {
+            //cada hilo busca en su parte de las aristas y luego combina
+            int mejor_local[NUM_TERRITORIOS];
+            for(int v = 0; v < NUM_TERRITORIOS; v++){
+                mejor_local[v] = -1;
             }
             
-            free(actual);
-            tabla->num_elementos--;
-            return;
+            #pragma omp for schedule(static)
+            for(int e = 0; e < m; e++){
+                int cu = componente[grafo->conexiones[e].u_territorio];
+                int cv = componente[grafo->conexiones[e].v_territorio];
+                if(cu == cv) continue;
+                
+                if(AristaMasBarata(grafo, e, mejor_local[cu])) mejor_local[cu] = e;
+                if(AristaMasBarata(grafo, e, mejor_local[cv])) mejor_local[cv] = e;
+            }
+            
+            #pragma omp critical
+            for(int v = 0; v < NUM_TERRITORIOS; v++){
+                if(mejor_local[v] != -1 && AristaMasBarata(grafo, mejor_local[v], mejor[v])){
+                    mejor[v] = mejor_local[v];
+                }
+            }
         }
         
-        anterior = actual;
-        actual = actual->siguiente;
+        for(int v = 0; v < NUM_TERRITORIOS; v++){
+            if(mejor[v] == -1) continue;
+            ConexionTerritorio *c = &grafo->conexiones[mejor[v]];
+            if(UnirUF(uf, c->u_territorio, c->v_territorio)){
+                aristas[num_aristas].territorio_u = c->u_territorio;
+                aristas[num_aristas].territorio_v = c->v_territorio;
+                aristas[num_aristas].peso = c->peso_proximidad;
+                num_aristas++;
+                hubo_union = 1;
+            }
+        }
     }
+    
+    LiberarUnionFind(uf);
+    free(mejor);
+    free(componente);
+    return num_aristas;
 }
 
-void MostrarEstadisticasHash(HashTable *tabla){
-    printf("\n========== HASH TABLE ==========\n");
-    printf("Tamaño: %d\n", HASH_SIZE);
-    printf("Elementos: %d\n", tabla->num_elementos);
+//muestra un bosque de expansion minima dado como lista de aristas
+void MostrarBosqueMST(Mapa *grafo, AristaMST *aristas, int num_aristas, const char *titulo){
+    printf("\n========== %s ==========\n", titulo);
+    printf("Conexiones:\n\n");
     
-    if(tabla->num_elementos == 0){
-        printf("\n⚠ Tabla vacía.\n");
-        printf("================================\n");
-        return;
+    float peso_total = 0.0;
+    for(int i = 0; i < num_aristas; i++){
+        printf("%-20s <-> %-20s (%.3f)\n",
+               grafo->territorios[aristas[i].territorio_u].Nombre,
+               grafo->territorios[aristas[i].territorio_v].Nombre,
+               aristas[i].peso);
+        peso_total += aristas[i].peso;
     }
     
-    printf("Factor de carga: %.4f\n", (float)tabla->num_elementos / HASH_SIZE);
+    printf("\n=========================\n");
+    printf("PESO TOTAL: %.3f\n", peso_total);
+    printf("ARISTAS: %d\n", num_aristas);
+    printf("COMPONENTES: %d\n", NUM_TERRITORIOS - num_aristas);
+    printf("=========================\n");
+}
+
+//calcula y muestra el bosque de expansion minima con kruskal
+void AlgoritmoKruskal(Mapa *grafo){
+    AristaMST aristas[NUM_TERRITORIOS];
+    int num_aristas = CalcularKruskal(grafo, aristas);
+    MostrarBosqueMST(grafo, aristas, num_aristas, "KRUSKAL");
+}
+
+//calcula y muestra el bosque de expansion minima con boruvka
+void AlgoritmoBoruvka(Mapa *grafo){
+    AristaMST aristas[NUM_TERRITORIOS];
+    int num_aristas = CalcularBoruvka(grafo, aristas);
+    MostrarBosqueMST(grafo, aristas, num_aristas, "BORUVKA");
+}
+
+//mide el tiempo promedio de prim, kruskal y boruvka sobre el mapa actual
+void CompararAlgoritmosMST(Mapa *grafo, int repeticiones){
+    printf("\n========== COMPARACION MST ==========\n");
+    printf("Territorios: %d | Conexiones: %d | Repeticiones: %d\n\n",
+           NUM_TERRITORIOS, grafo->num_conexiones, repeticiones);
+    
+    int padre[NUM_TERRITORIOS];
+    float clave[NUM_TERRITORIOS];
+    AristaMST aristas[NUM_TERRITORIOS];
+    float peso_prim = 0.0, peso_kruskal = 0.0, peso_boruvka = 0.0;
+    int n_kruskal = 0, n_boruvka = 0;
+    
+    double inicio = TiempoActual();
+    for(int r = 0; r < repeticiones; r++){
+        CalcularPrim(grafo, 0, padre, clave);
+    }
+    double t_prim = TiempoActual() - inicio;
+    peso_prim = CalcularPesoTotalMST(grafo, padre);
+    
+    inicio = TiempoActual();
+    for(int r = 0; r < repeticiones; r++){
+        n_kruskal = CalcularKruskal(grafo, aristas);
+    }
+    double t_kruskal = TiempoActual() - inicio;
+    for(int i = 0; i < n_kruskal; i++) peso_kruskal += aristas[i].peso;
+    
+    inicio = TiempoActual();
+    for(int r = 0; r < repeticiones; r++){
+        n_boruvka = CalcularBoruvka(grafo, aristas);
+    }
+    double t_boruvka = TiempoActual() - inicio;
+    for(int i = 0; i < n_boruvka; i++) peso_boruvka += aristas[i].peso;
+    
+    printf("%-10s %12s %12s\n", "Algoritmo", "us/corrida", "Peso total");
+    printf("--------------------------------------\n");
+    printf("%-10s %12.2f %12.3f\n", "Prim", t_prim * 1e6 / repeticiones, peso_prim);
+    printf("%-10s %12.2f %12.3f\n", "Kruskal", t_kruskal * 1e6 / repeticiones, peso_kruskal);
+    printf("%-10s %12.2f %12.3f\n", "Boruvka", t_boruvka * 1e6 / repeticiones, peso_boruvka);
+    printf("=====================================\n");
+}
+
+
+//=============================================================
+//bosque de expansion minima dinamico - reparacion local por arista modificada
+//=============================================================
+
+//reconstruye el bosque dinamico desde cero con kruskal
+void ConstruirMSTDinamico(Mapa *grafo){
+    AristaMST aristas[NUM_TERRITORIOS];
+    int num_aristas = CalcularKruskal(grafo, aristas);
+    
+    memset(grafo->mst_arista, 0, sizeof(grafo->mst_arista));
+    for(int i = 0; i < num_aristas; i++){
+        int u = aristas[i].territorio_u;
+        int v = aristas[i].territorio_v;
+        grafo->mst_arista[u][v] = grafo->mst_arista[v][u] = 1;
+    }
+    grafo->mst_valido = 1;
+}
+
+//construye el bosque dinamico solo si no existe o quedo obsoleto
+void AsegurarMSTDinamico(Mapa *grafo){
+    if(!grafo->mst_valido){
+        ConstruirMSTDinamico(grafo);
+    }
+}
+
+//busca en el bosque el camino de origen a destino; llena padre[] y retorna 1 si existe
+int CaminoEnMST(Mapa *grafo, int origen, int destino, int *padre){
+    int cola[NUM_TERRITORIOS];
+    int visitado[NUM_TERRITORIOS] = {0};
+    int frente = 0, fin = 0;
     
-    int buckets_usados = 0;
-    int max_colisiones = 0;
-    int total_colisiones = 0;
+    padre[origen] = -1;
+    visitado[origen] = 1;
+    cola[fin++] = origen;
     
-    for(int i = 0; i < HASH_SIZE; i++){
-        if(tabla->tabla[i] != NULL){
-            buckets_usados++;
-            
-            int longitud = 0;
-            NodoHash *actual = tabla->tabla[i];
-            while(actual != NULL){
-                longitud++;
-                actual = actual->siguiente;
+    while(frente < fin){
+        int u = cola[frente++];
+        if(u == destino) return 1;
+        for(int v = 0; v < NUM_TERRITORIOS; v++){
+            if(grafo->mst_arista[u][v] && !visitado[v]){
+                visitado[v] = 1;
+                padre[v] = u;
+                cola[fin++] = v;
             }
-            
-            if(longitud > 1){
-                total_colisiones += (longitud - 1);
+        }
+    }
+    return 0;
+}
+
+//repara el bosque despues de que la proximidad de u-v paso de peso_anterior al valor actual
+//una arista del arbol que empeora se reemplaza por la mejor arista que cruza el corte;
+//una arista fuera del arbol que mejora reemplaza a la peor del ciclo que cierra
+//retorna 1 si cambio el conjunto de aristas del bosque
+int ActualizarMSTDinamico(Mapa *grafo, int u, int v, float peso_anterior){
+    float peso = grafo->matrix[u][v];
+    
+    if(grafo->mst_arista[u][v]){
+        if(peso > 0.0 && peso >= peso_anterior) return 0;
+        
+        //quitar la arista y marcar el lado de u
+        grafo->mst_arista[u][v] = grafo->mst_arista[v][u] = 0;
+        int lado[NUM_TERRITORIOS] = {0};
+        int pila[NUM_TERRITORIOS];
+        int tope = 0;
+        lado[u] = 1;
+        pila[tope++] = u;
+        while(tope > 0){
+            int x = pila[--tope];
+            for(int y = 0; y < NUM_TERRITORIOS; y++){
+                if(grafo->mst_arista[x][y] && !lado[y]){
+                    lado[y] = 1;
+                    pila[tope++] = y;
+                }
             }
-            
-            if(longitud > max_colisiones){
-                max_colisiones = longitud;
+        }
+        
+        //mejor arista que cruza el corte (puede ser la misma u-v con su nuevo peso)
+        int mejor = -1;
+        for(int e = 0; e < grafo->num_conexiones; e++){
+            ConexionTerritorio *c = &grafo->conexiones[e];
+            if(lado[c->u_territorio] != lado[c->v_territorio] &&
+               (mejor == -1 || c->peso_proximidad > grafo->conexiones[mejor].peso_proximidad)){
+                mejor = e;
             }
         }
+        
+        if(mejor == -1) return 1;
+        int a = grafo->conexiones[mejor].u_territorio;
+        int b = grafo->conexiones[mejor].v_territorio;
+        grafo->mst_arista[a][b] = grafo->mst_arista[b][a] = 1;
+        return !((a == u && b == v) || (a == v && b == u));
     }
     
-    printf("Buckets usados: %d de %d (%.2f%%)\n", 
-           buckets_usados, HASH_SIZE, 
-           (float)buckets_usados * 100.0 / HASH_SIZE);
-    printf("Colisiones: %d\n", total_colisiones);
-    printf("Max cadena: %d\n", max_colisiones);
+    if(peso <= 0.0 || peso <= peso_anterior) return 0;
     
-    if(buckets_usados > 0){
-        printf("Promedio cadena: %.2f\n", 
-               (float)tabla->num_elementos / buckets_usados);
+    //la arista mejoro: revisar el ciclo que cierra con el arbol
+    int padre[NUM_TERRITORIOS];
+    if(!CaminoEnMST(grafo, u, v, padre)){
+        //conecta dos componentes del bosque
+        grafo->mst_arista[u][v] = grafo->mst_arista[v][u] = 1;
+        return 1;
+    }
+    
+    int peor_a = -1, peor_b = -1;
+    float peor = 2.0;
+    for(int x = v; padre[x] != -1; x = padre[x]){
+        if(grafo->matrix[x][padre[x]] < peor){
+            peor = grafo->matrix[x][padre[x]];
+            peor_a = x;
+            peor_b = padre[x];
+        }
+    }
+    
+    if(peor >= peso) return 0;
+    
+    grafo->mst_arista[peor_a][peor_b] = grafo->mst_arista[peor_b][peor_a] = 0;
+    grafo->mst_arista[u][v] = grafo->mst_arista[v][u] = 1;
+    return 1;
+}
+
+//suma de proximidades del bosque dinamico
+float PesoMSTDinamico(Mapa *grafo){
+    float total = 0.0;
+    for(int u = 0; u < NUM_TERRITORIOS; u++){
+        for(int v = u + 1; v < NUM_TERRITORIOS; v++){
+            if(grafo->mst_arista[u][v]) total += grafo->matrix[u][v];
+        }
+    }
+    return total;
+}
+
+//simula un cambio de proximidad y muestra como se repara la red de contencion
+void SimularCambioConexion(Mapa *grafo, int t1, int t2, float peso){
+    printf("\n========== ¿QUE PASARIA SI...? ==========\n");
+    
+    if(t1 < 0 || t1 >= NUM_TERRITORIOS || t2 < 0 || t2 >= NUM_TERRITORIOS || t1 == t2){
+        printf("Territorios invalidos\n");
+        return;
+    }
+    
+    AsegurarMSTDinamico(grafo);
+    
+    unsigned char antes[NUM_TERRITORIOS][NUM_TERRITORIOS];
+    memcpy(antes, grafo->mst_arista, sizeof(antes));
+    float peso_antes = PesoMSTDinamico(grafo);
+    float proximidad_anterior = grafo->matrix[t1][t2];
+    
+    double inicio = TiempoActual();
+    ModificarConexion(grafo, t1, t2, peso);
+    double tiempo = TiempoActual() - inicio;
+    
+    printf("%s <-> %s: %.3f -> %.3f\n", grafo->territorios[t1].Nombre, grafo->territorios[t2].Nombre,
+           proximidad_anterior, grafo->matrix[t1][t2]);
+    
+    int cambios = 0;
+    for(int u = 0; u < NUM_TERRITORIOS; u++){
+        for(int v = u + 1; v < NUM_TERRITORIOS; v++){
+            if(antes[u][v] && !grafo->mst_arista[u][v]){
+                printf("  - sale   %-15s <-> %-15s\n", grafo->territorios[u].Nombre, grafo->territorios[v].Nombre);
+                cambios++;
+            } else if(!antes[u][v] && grafo->mst_arista[u][v]){
+                printf("  + entra  %-15s <-> %-15s (%.3f)\n", grafo->territorios[u].Nombre,
+                       grafo->territorios[v].Nombre, grafo->matrix[u][v]);
+                cambios++;
+            }
+        }
+    }
+    if(cambios == 0){
+        printf("  La red de contencion no cambia de forma\n");
+    }
+    
+    printf("Peso total: %.3f -> %.3f\n", peso_antes, PesoMSTDinamico(grafo));
+    printf("Actualizacion: %.2f us\n", tiempo * 1e6);
+    
+    int mantener;
+    printf("\n¿Mantener el cambio? (1=Si, 0=No): ");
+    scanf("%d", &mantener);
+    getchar();
+    
+    if(!mantener){
+        ModificarConexion(grafo, t1, t2, proximidad_anterior);
+        printf("Cambio revertido (peso total: %.3f)\n", PesoMSTDinamico(grafo));
+    }
+    printf("=========================================\n");
+}
+
+//=============================================================
+//directorio de individuos por id - o(1) con un solo acceso
+//=============================================================
+
+//registra un individuo para busquedas por id
+//los ids densos (0..IDs-1 de CrearIndividuos) van a un arreglo plano indexado por id;
+//un id muy disperso (importado) iria a la tabla hash para no reservar huecos enormes
+void RegistrarIndividuo(Mapa *grafo, Individuo *ind){
+    if(ind == NULL || ind->ID < 0) return;
+    
+    long limite_denso = 4L * grafo->capacidad_directorio;
+    if(limite_denso < DIRECTORIO_CAPACIDAD_INICIAL) limite_denso = DIRECTORIO_CAPACIDAD_INICIAL;
+    
+    if(ind->ID >= limite_denso){
+        if(grafo->ids_dispersos == NULL){
+            grafo->ids_dispersos = CrearHashTable();
+        }
+        InsertarHash(grafo->ids_dispersos, ind);
+        return;
+    }
+    
+    if(ind->ID >= grafo->capacidad_directorio){
+        int nueva = grafo->capacidad_directorio > 0 ? grafo->capacidad_directorio : DIRECTORIO_CAPACIDAD_INICIAL;
+        while(nueva <= ind->ID){
+            nueva *= 2;
+        }
+        grafo->directorio = (Individuo**)realloc(grafo->directorio, nueva * sizeof(Individuo*));
+        for(int i = grafo->capacidad_directorio; i < nueva; i++){
+            grafo->directorio[i] = NULL;
+        }
+        grafo->capacidad_directorio = nueva;
+    }
+    grafo->directorio[ind->ID] = ind;
+}
+
+//individuo con un id dado (NULL si no existe)
+Individuo* IndividuoPorID(Mapa *grafo, int id){
+    if(id >= 0 && id < grafo->capacidad_directorio && grafo->directorio[id] != NULL){
+        return grafo->directorio[id];
+    }
+    if(grafo->ids_dispersos != NULL){
+        return BuscarHash(grafo->ids_dispersos, id);
+    }
+    return NULL;
+}
+
+//=============================================================
+//tabla hash para busqueda de individuos en o(1)
+//direccionamiento abierto robin hood: claves y valores en linea, sin nodos
+//=============================================================
+
+//crea una nueva tabla hash vacia para individuos
+HashTable* CrearHashTable(){
+    HashTable *tabla = (HashTable*)malloc(sizeof(HashTable));
+    tabla->capacidad = HASH_CAPACIDAD_INICIAL;
+    tabla->num_elementos = 0;
+    tabla->ranuras = (RanuraHash*)malloc(tabla->capacidad * sizeof(RanuraHash));
+    
+    for(int i = 0; i < tabla->capacidad; i++){
+        tabla->ranuras[i].ID = HASH_VACIO;
+    }
+    
+    return tabla;
+}
+
+//mezcla los bits del id (finalizador de murmur3) para que ids consecutivos se dispersen
+unsigned int FuncionHash(int id){
+    unsigned int h = (unsigned int)id;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+//coloca una entrada robin hood: quien esta mas lejos de su casa se queda la ranura
+//no revisa duplicados ni carga (uso interno)
+void ColocarRanuraHash(HashTable *tabla, int id, Individuo *individuo){
+    unsigned int mascara = (unsigned int)tabla->capacidad - 1;
+    unsigned int pos = FuncionHash(id) & mascara;
+    RanuraHash actual = {id, 0, individuo};
+    
+    while(1){
+        RanuraHash *ranura = &tabla->ranuras[pos];
+        if(ranura->ID == HASH_VACIO){
+            *ranura = actual;
+            tabla->num_elementos++;
+            return;
+        }
+        if(ranura->distancia < actual.distancia){
+            RanuraHash temp = *ranura;
+            *ranura = actual;
+            actual = temp;
+        }
+        pos = (pos + 1) & mascara;
+        actual.distancia++;
+    }
+}
+
+//cambia la capacidad (potencia de 2) y reubica todas las entradas
+void RedimensionarHash(HashTable *tabla, int nueva_capacidad){
+    RanuraHash *viejas = tabla->ranuras;
+    int capacidad_vieja = tabla->capacidad;
+    
+    tabla->ranuras = (RanuraHash*)malloc(nueva_capacidad * sizeof(RanuraHash));
+    tabla->capacidad = nueva_capacidad;
+    tabla->num_elementos = 0;
+    for(int i = 0; i < nueva_capacidad; i++){
+        tabla->ranuras[i].ID = HASH_VACIO;
+    }
+    
+    for(int i = 0; i < capacidad_vieja; i++){
+        if(viejas[i].ID != HASH_VACIO){
+            ColocarRanuraHash(tabla, viejas[i].ID, viejas[i].individuo);
+        }
+    }
+    free(viejas);
+}
+
+//asegura espacio para num_elementos sin pasar la carga maxima (evita crecer de a poco)
+void ReservarHash(HashTable *tabla, int num_elementos){
+    long capacidad = tabla->capacidad;
+    while((long)num_elementos * HASH_CARGA_DEN > capacidad * HASH_CARGA_NUM){
+        capacidad *= 2;
+    }
+    if(capacidad != tabla->capacidad){
+        RedimensionarHash(tabla, (int)capacidad);
+    }
+}
+
+//posicion de un id en la tabla (-1 si no esta)
+//se corta en cuanto la ranura esta mas cerca de su casa que el id buscado
+int PosicionHash(HashTable *tabla, int id){
+    unsigned int mascara = (unsigned int)tabla->capacidad - 1;
+    unsigned int pos = FuncionHash(id) & mascara;
+    
+    for(int distancia = 0; ; distancia++){
+        RanuraHash *ranura = &tabla->ranuras[pos];
+        if(ranura->ID == id) return (int)pos;
+        if(ranura->ID == HASH_VACIO || ranura->distancia < distancia) return -1;
+        pos = (pos + 1) & mascara;
+    }
+}
+
+//inserta un individuo en la tabla hash (si el id ya existe actualiza el puntero)
+void InsertarHash(HashTable *tabla, Individuo *individuo){
+    if(individuo == NULL || individuo->ID == HASH_VACIO) return;
+    
+    int pos = PosicionHash(tabla, individuo->ID);
+    if(pos >= 0){
+        tabla->ranuras[pos].individuo = individuo;
+        return;
+    }
+    
+    ReservarHash(tabla, tabla->num_elementos + 1);
+    ColocarRanuraHash(tabla, individuo->ID, individuo);
+}
+
+//busca un individuo por id en la tabla hash - o(1)
+Individuo* BuscarHash(HashTable *tabla, int id){
+    int pos = PosicionHash(tabla, id);
+    return pos >= 0 ? tabla->ranuras[pos].individuo : NULL;
+}
+
+//elimina por desplazamiento hacia atras (sin lapidas): las entradas siguientes
+//se acercan una ranura a su casa hasta encontrar un hueco o una entrada en su casa
+void EliminarHash(HashTable *tabla, int id){
+    int pos = PosicionHash(tabla, id);
+    if(pos < 0) return;
+    
+    unsigned int mascara = (unsigned int)tabla->capacidad - 1;
+    unsigned int actual = (unsigned int)pos;
+    unsigned int siguiente = (actual + 1) & mascara;
+    
+    while(tabla->ranuras[siguiente].ID != HASH_VACIO && tabla->ranuras[siguiente].distancia > 0){
+        tabla->ranuras[actual] = tabla->ranuras[siguiente];
+        tabla->ranuras[actual].distancia--;
+        actual = siguiente;
+        siguiente = (siguiente + 1) & mascara;
+    }
+    tabla->ranuras[actual].ID = HASH_VACIO;
+    tabla->num_elementos--;
+}
+
+void MostrarEstadisticasHash(HashTable *tabla){
+    printf("\n========== HASH TABLE ==========\n");
+    printf("Tipo: direccionamiento abierto (robin hood)\n");
+    printf("Capacidad: %d ranuras (%d bytes c/u)\n", tabla->capacidad, (int)sizeof(RanuraHash));
+    printf("Elementos: %d\n", tabla->num_elementos);
+    
+    if(tabla->num_elementos == 0){
+        printf("\n⚠ Tabla vacía.\n");
+        printf("================================\n");
+        return;
+    }
+    
+    printf("Factor de carga: %.4f (maximo %.3f)\n", (float)tabla->num_elementos / tabla->capacidad,
+           (float)HASH_CARGA_NUM / HASH_CARGA_DEN);
+    
+    //sondeos de una busqueda exitosa = distancia a casa + 1
+    int histograma[6] = {0};
+    const char *etiquetas[] = {"1", "2", "3", "4", "5-8", "9+"};
+    long total_sondeos = 0;
+    int max_sondeos = 0;
+    int en_casa = 0;
+    
+    for(int i = 0; i < tabla->capacidad; i++){
+        if(tabla->ranuras[i].ID == HASH_VACIO) continue;
+        int sondeos = tabla->ranuras[i].distancia + 1;
+        total_sondeos += sondeos;
+        if(sondeos > max_sondeos) max_sondeos = sondeos;
+        if(sondeos == 1) en_casa++;
+        histograma[sondeos <= 4 ? sondeos - 1 : (sondeos <= 8 ? 4 : 5)]++;
+    }
+    
+    //busqueda fallida desde cada ranura: avanza mientras la distancia no corte
+    long total_fallidos = 0;
+    for(int i = 0; i < tabla->capacidad; i++){
+        int pos = i;
+        int sondeos = 1;
+        for(int d = 0; tabla->ranuras[pos].ID != HASH_VACIO && tabla->ranuras[pos].distancia >= d; d++){
+            pos = (pos + 1) & (tabla->capacidad - 1);
+            sondeos++;
+        }
+        total_fallidos += sondeos;
+    }
+    
+    float promedio = (float)total_sondeos / tabla->num_elementos;
+    int por_linea = 64 / (int)sizeof(RanuraHash);
+    
+    printf("En su posicion ideal: %d (%.2f%%)\n", en_casa, (float)en_casa * 100.0 / tabla->num_elementos);
+    printf("Sondeos busqueda exitosa: promedio %.3f | maximo %d\n", promedio, max_sondeos);
+    printf("Sondeos busqueda fallida: promedio %.3f\n", (float)total_fallidos / tabla->capacidad);
+    printf("Lineas de cache por busqueda (~%d ranuras/linea): %.2f\n", por_linea, 1.0 + (promedio - 1.0) / por_linea);
+    
+    printf("\nDistribucion de sondeos:\n");
+    for(int i = 0; i < 6; i++){
+        printf("  %-4s: %7d (%.2f%%)\n", etiquetas[i], histograma[i], (float)histograma[i] * 100.0 / tabla->num_elementos);
     }
     
     printf("================================\n");
@@ -2091,6 +4353,12 @@ void InicializarHashTable(Mapa *grafo){
     
     grafo->hash_individuos = CrearHashTable();
     
+    int total = 0;
+    for(int t = 0; t < NUM_TERRITORIOS; t++){
+        total += grafo->territorios[t].num_individuos;
+    }
+    ReservarHash(grafo->hash_individuos, total);
+    
     int insertados = 0;
     
     for(int t = 0; t < NUM_TERRITORIOS; t++){
@@ -2108,396 +4376,3117 @@ void InicializarHashTable(Mapa *grafo){
 }
 
 void LiberarHashTable(HashTable *tabla){
-    for(int i = 0; i < HASH_SIZE; i++){
-        NodoHash *actual = tabla->tabla[i];
-        while(actual != NULL){
-            NodoHash *siguiente = actual->siguiente;
-            free(actual);
-            actual = siguiente;
+    free(tabla->ranuras);
+    free(tabla);
+}
+
+//=============================================================
+//hash concurrente de individuos: lecturas sin bloqueo, escrituras por franjas
+//y liberacion diferida por epocas
+//=============================================================
+
+//toma un candado de giro (intercambio atomico + espera leyendo)
+void TomarCandadoGiro(int *candado){
+    while(__atomic_exchange_n(candado, 1, __ATOMIC_ACQUIRE)){
+        while(__atomic_load_n(candado, __ATOMIC_RELAXED)){
         }
     }
-    free(tabla);
 }
 
-void PruebaRendimientoHash(Mapa *grafo){
-    printf("\n========== PRUEBA RENDIMIENTO ==========\n");
-    
-    if(grafo->hash_individuos == NULL){
-        printf("Hash Table no inicializada.\n");
-        return;
+void SoltarCandadoGiro(int *candado){
+    __atomic_store_n(candado, 0, __ATOMIC_RELEASE);
+}
+
+//arreglo de cubetas vacio (la tabla se publica con una sola escritura atomica)
+TablaHashConcurrente* CrearTablaHashConcurrente(int num_cubetas){
+    TablaHashConcurrente *tabla = (TablaHashConcurrente*)malloc(sizeof(TablaHashConcurrente));
+    tabla->num_cubetas = num_cubetas;
+    tabla->cubetas = (NodoHashConcurrente**)calloc(num_cubetas, sizeof(NodoHashConcurrente*));
+    return tabla;
+}
+
+HashConcurrente* CrearHashConcurrente(int capacidad){
+    HashConcurrente *hc = (HashConcurrente*)malloc(sizeof(HashConcurrente));
+    int cubetas = FRANJAS_CONCURRENTE;
+    while(cubetas < capacidad){
+        cubetas *= 2;
+    }
+    hc->tabla = CrearTablaHashConcurrente(cubetas);
+    hc->num_elementos = 0;
+    hc->epoca_global = 0;
+    hc->retirados = NULL;
+    hc->num_retirados = 0;
+    hc->candado_retirados = 0;
+    for(int f = 0; f < FRANJAS_CONCURRENTE; f++){
+        hc->franjas[f] = 0;
+    }
+    for(int h = 0; h < MAX_HILOS_CONCURRENTE; h++){
+        hc->epocas[h].estado = 0;
+    }
+    return hc;
+}
+
+//anuncia que el hilo va a leer: (epoca << 1) | 1 mientras esta activo
+//se repite hasta anunciar la epoca vigente para que el reclamador no la salte
+void EntrarEpoca(HashConcurrente *hc, int hilo){
+    unsigned long epoca;
+    do{
+        epoca = __atomic_load_n(&hc->epoca_global, __ATOMIC_SEQ_CST);
+        __atomic_store_n(&hc->epocas[hilo].estado, (epoca << 1) | 1, __ATOMIC_SEQ_CST);
+    } while(__atomic_load_n(&hc->epoca_global, __ATOMIC_SEQ_CST) != epoca);
+}
+
+void SalirEpoca(HashConcurrente *hc, int hilo){
+    __atomic_store_n(&hc->epocas[hilo].estado, 0, __ATOMIC_RELEASE);
+}
+
+//intenta avanzar la epoca global y libera lo retirado hace dos epocas o mas
+//(ningun lector activo puede seguir viendo esos bloques)
+void ReclamarEpocas(HashConcurrente *hc){
+    unsigned long epoca = __atomic_load_n(&hc->epoca_global, __ATOMIC_SEQ_CST);
+    
+    for(int h = 0; h < MAX_HILOS_CONCURRENTE; h++){
+        unsigned long estado = __atomic_load_n(&hc->epocas[h].estado, __ATOMIC_SEQ_CST);
+        if((estado & 1) && (estado >> 1) != epoca) return;
+    }
+    __atomic_compare_exchange_n(&hc->epoca_global, &epoca, epoca + 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    
+    unsigned long vigente = __atomic_load_n(&hc->epoca_global, __ATOMIC_SEQ_CST);
+    TomarCandadoGiro(&hc->candado_retirados);
+    RetiradoEpoca **enlace = &hc->retirados;
+    while(*enlace != NULL){
+        RetiradoEpoca *r = *enlace;
+        if(r->epoca + 2 <= vigente){
+            *enlace = r->siguiente;
+            free(r->bloque);
+            free(r);
+            hc->num_retirados--;
+        } else {
+            enlace = &r->siguiente;
+        }
     }
+    SoltarCandadoGiro(&hc->candado_retirados);
+}
+
+//deja un bloque pendiente de liberar hasta que ningun lector pueda verlo
+void RetirarBloque(HashConcurrente *hc, void *bloque){
+    RetiradoEpoca *r = (RetiradoEpoca*)malloc(sizeof(RetiradoEpoca));
+    r->bloque = bloque;
+    r->epoca = __atomic_load_n(&hc->epoca_global, __ATOMIC_SEQ_CST);
     
-    int total_individuos = 0;
-    for(int t = 0; t < NUM_TERRITORIOS; t++){
-        total_individuos += grafo->territorios[t].num_individuos;
-    }
+    TomarCandadoGiro(&hc->candado_retirados);
+    r->siguiente = hc->retirados;
+    hc->retirados = r;
+    int pendientes = ++hc->num_retirados;
+    SoltarCandadoGiro(&hc->candado_retirados);
     
-    if(total_individuos == 0){
-        printf("No hay individuos.\n");
-        return;
+    if(pendientes % 64 == 0){
+        ReclamarEpocas(hc);
     }
+}
+
+//busqueda sin candados: solo lecturas atomicas dentro de una epoca
+Individuo* BuscarHashConcurrente(HashConcurrente *hc, int id){
+    int hilo = HiloActual();
+    EntrarEpoca(hc, hilo);
     
-    int *ids_validos = (int*)malloc(total_individuos * sizeof(int));
-    int idx = 0;
+    TablaHashConcurrente *tabla = __atomic_load_n(&hc->tabla, __ATOMIC_ACQUIRE);
+    unsigned int cubeta = FuncionHash(id) & (unsigned int)(tabla->num_cubetas - 1);
+    NodoHashConcurrente *nodo = __atomic_load_n(&tabla->cubetas[cubeta], __ATOMIC_ACQUIRE);
+    Individuo *resultado = NULL;
     
-    for(int t = 0; t < NUM_TERRITORIOS; t++){
-        Territorio *territorio = &grafo->territorios[t];
-        for(int i = 0; i < territorio->num_individuos; i++){
-            if(territorio->individuos[i] != NULL){
-                ids_validos[idx++] = territorio->individuos[i]->ID;
-            }
+    while(nodo != NULL){
+        if(nodo->ID == id){
+            resultado = __atomic_load_n(&nodo->individuo, __ATOMIC_ACQUIRE);
+            break;
         }
+        nodo = __atomic_load_n(&nodo->siguiente, __ATOMIC_ACQUIRE);
     }
     
-    int num_pruebas = (total_individuos < 1000) ? total_individuos : 1000;
-    
-    printf("Búsquedas: %d\n", num_pruebas);
-    
-    int encontrados = 0;
-    
-    for(int i = 0; i < num_pruebas; i++){
-        int idx_aleatorio = (int)(Azar(0, idx - 1));
-        if(idx_aleatorio >= idx) idx_aleatorio = idx - 1;
-        if(idx_aleatorio < 0) idx_aleatorio = 0;
-        
-        int id_buscar = ids_validos[idx_aleatorio];
-        
-        Individuo *resultado = BuscarHash(grafo->hash_individuos, id_buscar);
-        if(resultado != NULL){
-            encontrados++;
-        }
+    SalirEpoca(hc, hilo);
+    return resultado;
+}
+
+//duplica las cubetas con todas las franjas tomadas (en orden, sin interbloqueo)
+//los nodos se copian: los lectores que siguen en la tabla vieja la ven intacta
+void CrecerHashConcurrente(HashConcurrente *hc){
+    for(int f = 0; f < FRANJAS_CONCURRENTE; f++){
+        TomarCandadoGiro(&hc->franjas[f]);
     }
     
-    printf("\nResultados:\n");
-    printf("Encontrados: %d\n", encontrados);
-    printf("Tasa éxito: %.2f%%\n", (float)encontrados * 100.0 / num_pruebas);
-    
-    printf("\nEficiencia:\n");
-    printf("Hash Table: O(1)\n");
-    printf("Búsqueda lineal: O(%d)\n", total_individuos);
-    printf("Mejora: ~%dx\n", total_individuos / 10);
-    
-    printf("\nEjemplos (primeros 5):\n");
-    int mostrados = 0;
-    
-    for(int i = 0; i < num_pruebas && mostrados < 5; i++){
-        int idx_aleatorio = (int)(Azar(0, idx - 1));
-        if(idx_aleatorio >= idx) idx_aleatorio = idx - 1;
-        if(idx_aleatorio < 0) idx_aleatorio = 0;
+    TablaHashConcurrente *vieja = hc->tabla;
+    if(__atomic_load_n(&hc->num_elementos, __ATOMIC_RELAXED) > 2 * vieja->num_cubetas){
+        TablaHashConcurrente *nueva = CrearTablaHashConcurrente(vieja->num_cubetas * 2);
         
-        int id_buscar = ids_validos[idx_aleatorio];
-        Individuo *resultado = BuscarHash(grafo->hash_individuos, id_buscar);
+        for(int c = 0; c < vieja->num_cubetas; c++){
+            for(NodoHashConcurrente *nodo = vieja->cubetas[c]; nodo != NULL; nodo = nodo->siguiente){
+                NodoHashConcurrente *copia = (NodoHashConcurrente*)malloc(sizeof(NodoHashConcurrente));
+                unsigned int destino = FuncionHash(nodo->ID) & (unsigned int)(nueva->num_cubetas - 1);
+                copia->ID = nodo->ID;
+                copia->individuo = nodo->individuo;
+                copia->siguiente = nueva->cubetas[destino];
+                nueva->cubetas[destino] = copia;
+            }
+        }
+        __atomic_store_n(&hc->tabla, nueva, __ATOMIC_RELEASE);
         
-        if(resultado != NULL){
-            printf("  ID %d: %s (%s)\n",
-                   resultado->ID,
-                   resultado->Nombre,
-                   grafo->territorios[resultado->Territorio_ID].Nombre);
-            mostrados++;
+        for(int c = 0; c < vieja->num_cubetas; c++){
+            NodoHashConcurrente *nodo = vieja->cubetas[c];
+            while(nodo != NULL){
+                NodoHashConcurrente *siguiente = nodo->siguiente;
+                RetirarBloque(hc, nodo);
+                nodo = siguiente;
+            }
         }
+        RetirarBloque(hc, vieja->cubetas);
+        RetirarBloque(hc, vieja);
     }
     
-    printf("========================================\n");
-    
-    free(ids_validos);
+    for(int f = FRANJAS_CONCURRENTE - 1; f >= 0; f--){
+        SoltarCandadoGiro(&hc->franjas[f]);
+    }
 }
 
-//=============================================================
-//rutas criticas de contagio con dijkstra - o((n+m) log n)
-//=============================================================
-
-//reconstruye y muestra la ruta desde origen hasta destino
-void ReconstruirRuta(Mapa *grafo, int origen, int destino, int *padre){
-    if(destino == origen){
-        printf("%s", grafo->territorios[origen].Nombre);
-        return;
+//inserta o actualiza bajo el candado de la franja de la clave
+//el nodo nuevo se publica en la cabeza de la cubeta con una escritura de liberacion
+void InsertarHashConcurrente(HashConcurrente *hc, int id, Individuo *individuo){
+    unsigned int h = FuncionHash(id);
+    int *franja = &hc->franjas[h & (FRANJAS_CONCURRENTE - 1)];
+    int insertado = 0;
+    
+    TomarCandadoGiro(franja);
+    TablaHashConcurrente *tabla = hc->tabla;
+    NodoHashConcurrente **cabeza = &tabla->cubetas[h & (unsigned int)(tabla->num_cubetas - 1)];
+    
+    NodoHashConcurrente *nodo = *cabeza;
+    while(nodo != NULL && nodo->ID != id){
+        nodo = nodo->siguiente;
     }
     
-    if(padre[destino] == -1){
-        printf("(No hay ruta)");
-        return;
+    if(nodo != NULL){
+        __atomic_store_n(&nodo->individuo, individuo, __ATOMIC_RELEASE);
+    } else {
+        NodoHashConcurrente *nuevo = (NodoHashConcurrente*)malloc(sizeof(NodoHashConcurrente));
+        nuevo->ID = id;
+        nuevo->individuo = individuo;
+        nuevo->siguiente = *cabeza;
+        __atomic_store_n(cabeza, nuevo, __ATOMIC_RELEASE);
+        insertado = 1;
     }
+    int cubetas = tabla->num_cubetas;
+    SoltarCandadoGiro(franja);
     
-    ReconstruirRuta(grafo, origen, padre[destino], padre);
-    printf(" -> %s", grafo->territorios[destino].Nombre);
+    if(insertado && __atomic_add_fetch(&hc->num_elementos, 1, __ATOMIC_RELAXED) > 2 * cubetas){
+        CrecerHashConcurrente(hc);
+    }
 }
 
-void MostrarRutasCriticas(Mapa *grafo, int origen, float *distancia, int *padre){
-    printf("\n========== RUTAS CRÍTICAS DESDE %s ==========\n", 
-           grafo->territorios[origen].Nombre);
-    
-    printf("\n%-20s %10s %s\n", "Destino", "Distancia", "Ruta");
-    printf("-----------------------------------------------------------\n");
-    
-    // Ordenar destinos por distancia
-    typedef struct {
-        int territorio;
-        float distancia;
-    } DistanciaTerritorio;
+//desenlaza el nodo (el resto de la cadena queda intacto para los lectores en curso) y lo retira
+void EliminarHashConcurrente(HashConcurrente *hc, int id){
+    unsigned int h = FuncionHash(id);
+    int *franja = &hc->franjas[h & (FRANJAS_CONCURRENTE - 1)];
+    NodoHashConcurrente *eliminado = NULL;
     
-    DistanciaTerritorio destinos[NUM_TERRITORIOS];
-    int num_destinos = 0;
+    TomarCandadoGiro(franja);
+    TablaHashConcurrente *tabla = hc->tabla;
+    NodoHashConcurrente **enlace = &tabla->cubetas[h & (unsigned int)(tabla->num_cubetas - 1)];
     
-    for(int v = 0; v < NUM_TERRITORIOS; v++){
-        if(v != origen && distancia[v] < 999999.0){
-            destinos[num_destinos].territorio = v;
-            destinos[num_destinos].distancia = distancia[v];
-            num_destinos++;
+    while(*enlace != NULL){
+        if((*enlace)->ID == id){
+            eliminado = *enlace;
+            __atomic_store_n(enlace, eliminado->siguiente, __ATOMIC_RELEASE);
+            break;
         }
+        enlace = &(*enlace)->siguiente;
     }
+    SoltarCandadoGiro(franja);
     
-    // Ordenar por distancia (burbuja simple)
-    for(int i = 0; i < num_destinos - 1; i++){
-        for(int j = 0; j < num_destinos - i - 1; j++){
-            if(destinos[j].distancia > destinos[j+1].distancia){
-                DistanciaTerritorio temp = destinos[j];
-                destinos[j] = destinos[j+1];
-                destinos[j+1] = temp;
-            }
+    if(eliminado != NULL){
+        __atomic_sub_fetch(&hc->num_elementos, 1, __ATOMIC_RELAXED);
+        RetirarBloque(hc, eliminado);
+    }
+}
+
+//libera todo (sin hilos activos)
+void LiberarHashConcurrente(HashConcurrente *hc){
+    TablaHashConcurrente *tabla = hc->tabla;
+    for(int c = 0; c < tabla->num_cubetas; c++){
+        NodoHashConcurrente *nodo = tabla->cubetas[c];
+        while(nodo != NULL){
+            NodoHashConcurrente *siguiente = nodo->siguiente;
+            free(nodo);
+            nodo = siguiente;
         }
     }
+    free(tabla->cubetas);
+    free(tabla);
     
-    // Mostrar todos los destinos alcanzables
-    for(int i = 0; i < num_destinos; i++){
-        int v = destinos[i].territorio;
-        printf("%-20s %10.3f  ", 
-               grafo->territorios[v].Nombre, 
-               distancia[v]);
-        ReconstruirRuta(grafo, origen, v, padre);
-        printf("\n");
+    while(hc->retirados != NULL){
+        RetiradoEpoca *r = hc->retirados;
+        hc->retirados = r->siguiente;
+        free(r->bloque);
+        free(r);
     }
+    free(hc);
+}
+
+//lectores consultando mientras un escritor borra y reinserta ids sin pausa
+//los ids pares nunca se borran (deben encontrarse siempre); los impares rotan
+//reporta consultas por segundo para 1, 2, 4... lectores y verifica cada respuesta
+void PruebaHashConcurrente(Mapa *grafo){
+    printf("\n========== HASH CONCURRENTE (LECTURAS SIN BLOQUEO) ==========\n");
     
-    // Identificar territorios inalcanzables
-    int inalcanzables = 0;
-    for(int v = 0; v < NUM_TERRITORIOS; v++){
-        if(v != origen && distancia[v] >= 999999.0){
-            inalcanzables++;
-        }
+    int n = IDs;
+    if(n <= 1){
+        printf("No hay individuos.\n");
+        return;
     }
     
-    if(inalcanzables > 0){
-        printf("\n⚠ Territorios inalcanzables: %d\n", inalcanzables);
-    }
+    int consultas_por_lector = 2000000;
+    int hilos = 1;
+#ifdef _OPENMP
+    hilos = omp_get_max_threads();
+    if(hilos > MAX_HILOS_CONCURRENTE) hilos = MAX_HILOS_CONCURRENTE;
+#endif
     
-    printf("\n============================================================\n");
+    printf("Individuos: %d | Consultas por lector: %d | Hilos disponibles: %d\n", n, consultas_por_lector, hilos);
+    printf("Escritor: borra y reinserta ids impares continuamente\n");
     
-    // Análisis de rutas críticas
-    printf("\n--- ANÁLISIS DE RUTAS CRÍTICAS ---\n");
+    printf("\n%-9s %16s %14s %12s %10s\n", "Lectores", "Consultas/s", "ns/consulta", "Mutaciones", "Errores");
+    printf("-------------------------------------------------------------------\n");
     
-    // Ruta más corta
-    if(num_destinos > 0){
-        int mas_cercano = destinos[0].territorio;
-        printf("\nTerritorio más cercano:\n");
-        printf("  %s (distancia: %.3f)\n", 
-               grafo->territorios[mas_cercano].Nombre,
-               distancia[mas_cercano]);
-        printf("  Ruta: ");
-        ReconstruirRuta(grafo, origen, mas_cercano, padre);
-        printf("\n");
+    int max_lectores = hilos > 1 ? hilos - 1 : 1;
+    for(int lectores = 1; lectores <= max_lectores; lectores *= 2){
+        HashConcurrente *hc = CrearHashConcurrente(16);
+        for(int id = 0; id < n; id++){
+            Individuo *ind = IndividuoPorID(grafo, id);
+            if(ind != NULL) InsertarHashConcurrente(hc, id, ind);
+        }
+        
+        int terminados = 0;
+        long mutaciones = 0;
+        long errores = 0;
+        double tiempo_lectores = 0.0;
+        
+#ifdef _OPENMP
+        if(hilos > 1){
+            #pragma omp parallel num_threads(lectores + 1) reduction(+:errores)
+            {
+                int yo = omp_get_thread_num();
+                unsigned long long estado = 0x9E3779B97F4A7C15ULL * (yo + 1);
+                
+                if(yo == 0){
+                    //escritor: muta hasta que todos los lectores terminan
+                    long propias = 0;
+                    while(__atomic_load_n(&terminados, __ATOMIC_ACQUIRE) < lectores){
+                        int id = (int)(SiguienteXorshift(&estado) % (unsigned long long)n) | 1;
+                        if(id >= n) continue;
+                        EliminarHashConcurrente(hc, id);
+                        InsertarHashConcurrente(hc, id, IndividuoPorID(grafo, id));
+                        propias++;
+                    }
+                    mutaciones = propias;
+                } else {
+                    double inicio = TiempoActual();
+                    for(int i = 0; i < consultas_por_lector; i++){
+                        int id = (int)(SiguienteXorshift(&estado) % (unsigned long long)n);
+                        Individuo *r = BuscarHashConcurrente(hc, id);
+                        if(r != NULL ? r != IndividuoPorID(grafo, id) : (id % 2 == 0)) errores++;
+                    }
+                    double t = TiempoActual() - inicio;
+                    #pragma omp critical
+                    {
+                        if(t > tiempo_lectores) tiempo_lectores = t;
+                    }
+                    __atomic_add_fetch(&terminados, 1, __ATOMIC_RELEASE);
+                }
+            }
+        } else
+#endif
+        {
+            //sin hilos: lector y escritor intercalados (una mutacion cada 64 consultas)
+            unsigned long long estado = 0x9E3779B97F4A7C15ULL;
+            double inicio = TiempoActual();
+            for(int i = 0; i < consultas_por_lector; i++){
+                int id = (int)(SiguienteXorshift(&estado) % (unsigned long long)n);
+                Individuo *r = BuscarHashConcurrente(hc, id);
+                if(r != NULL ? r != IndividuoPorID(grafo, id) : (id % 2 == 0)) errores++;
+                
+                if(i % 64 == 0){
+                    int mutado = (int)(SiguienteXorshift(&estado) % (unsigned long long)n) | 1;
+                    if(mutado < n){
+                        EliminarHashConcurrente(hc, mutado);
+                        InsertarHashConcurrente(hc, mutado, IndividuoPorID(grafo, mutado));
+                        mutaciones++;
+                    }
+                }
+            }
+            tiempo_lectores = TiempoActual() - inicio;
+        }
+        (void)terminados;
+        
+        double total = (double)consultas_por_lector * lectores;
+        printf("%-9d %16.0f %14.1f %12ld %10ld\n", lectores, total / tiempo_lectores,
+               tiempo_lectores * 1e9 / consultas_por_lector, mutaciones, errores);
+        
+        LiberarHashConcurrente(hc);
     }
     
-    // Ruta más larga
-    if(num_destinos > 0){
-        int mas_lejano = destinos[num_destinos-1].territorio;
-        printf("\nTerritorio más lejano:\n");
-        printf("  %s (distancia: %.3f)\n", 
-               grafo->territorios[mas_lejano].Nombre,
-               distancia[mas_lejano]);
-        printf("  Ruta: ");
-        ReconstruirRuta(grafo, origen, mas_lejano, padre);
-        printf("\n");
+    printf("\nErrores = consultas que devolvieron otro individuo o no hallaron un id estable.\n");
+    printf("=============================================================\n");
+}
+
+//=============================================================
+//prueba de rendimiento de estructuras de busqueda por id
+//=============================================================
+
+//tabla encadenada de referencia (un nodo por insercion), con tantas cubetas como potencia de 2 >= n
+TablaEncadenada* CrearTablaEncadenada(int n){
+    TablaEncadenada *tabla = (TablaEncadenada*)malloc(sizeof(TablaEncadenada));
+    tabla->num_cubetas = 1;
+    while(tabla->num_cubetas < n){
+        tabla->num_cubetas *= 2;
+    }
+    tabla->cubetas = (NodoEncadenado**)calloc(tabla->num_cubetas, sizeof(NodoEncadenado*));
+    return tabla;
+}
+
+void InsertarEncadenada(TablaEncadenada *tabla, int id, Individuo *individuo){
+    unsigned int indice = FuncionHash(id) & (unsigned int)(tabla->num_cubetas - 1);
+    NodoEncadenado *nuevo = (NodoEncadenado*)malloc(sizeof(NodoEncadenado));
+    nuevo->ID = id;
+    nuevo->individuo = individuo;
+    nuevo->siguiente = tabla->cubetas[indice];
+    tabla->cubetas[indice] = nuevo;
+}
+
+Individuo* BuscarEncadenada(TablaEncadenada *tabla, int id){
+    unsigned int indice = FuncionHash(id) & (unsigned int)(tabla->num_cubetas - 1);
+    for(NodoEncadenado *actual = tabla->cubetas[indice]; actual != NULL; actual = actual->siguiente){
+        if(actual->ID == id) return actual->individuo;
+    }
+    return NULL;
+}
+
+void LiberarTablaEncadenada(TablaEncadenada *tabla){
+    for(int i = 0; i < tabla->num_cubetas; i++){
+        NodoEncadenado *actual = tabla->cubetas[i];
+        while(actual != NULL){
+            NodoEncadenado *siguiente = actual->siguiente;
+            free(actual);
+            actual = siguiente;
+        }
+    }
+    free(tabla->cubetas);
+    free(tabla);
+}
+
+//generador xorshift de la prueba (no altera la secuencia de rand())
+unsigned long long SiguienteXorshift(unsigned long long *estado){
+    unsigned long long x = *estado;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *estado = x;
+    return x;
+}
+
+int CompararDouble(const void *a, const void *b){
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+//escribe un bloque grande de memoria para sacar de la cache las estructuras (corridas en frio)
+void LimpiarCachePrueba(unsigned char *bloque, long tam){
+    for(long i = 0; i < tam; i += 64){
+        bloque[i]++;
     }
+}
+
+//ejecuta las consultas en lotes y guarda los ns por consulta de cada lote, retorna los aciertos
+int MedirConsultasHash(EstructurasPrueba *ep, int estructura, const int *consultas, int num, double *ns_lote){
+    int aciertos = 0;
     
-    // Rutas de alto riesgo (distancia corta)
-    printf("\nRutas de ALTO RIESGO (distancia < 2.0):\n");
-    int rutas_alto_riesgo = 0;
-    for(int i = 0; i < num_destinos && destinos[i].distancia < 2.0; i++){
+    for(int b = 0, l = 0; b < num; b += LOTE_PRUEBA_HASH, l++){
+        int fin = (b + LOTE_PRUEBA_HASH < num) ? b + LOTE_PRUEBA_HASH : num;
+        double t0 = TiempoActual();
+        
+        switch(estructura){
+            case 0:
+                for(int i = b; i < fin; i++){
+                    aciertos += BuscarEncadenada(ep->encadenada, consultas[i]) != NULL;
+                }
+                break;
+            case 1:
+                for(int i = b; i < fin; i++){
+                    aciertos += BuscarHash(ep->abierta, consultas[i]) != NULL;
+                }
+                break;
+            case 2:
+                for(int i = b; i < fin; i++){
+                    int id = consultas[i];
+                    aciertos += (id >= 0 && id < ep->n && ep->directa[id] != NULL);
+                }
+                break;
+            default:
+                for(int i = b; i < fin; i++){
+                    for(int k = 0; k < ep->n; k++){
+                        if(ep->lineal_ids[k] == consultas[i]){
+                            aciertos += ep->directa[k] != NULL;
+                            break;
+                        }
+                    }
+                }
+                break;
+        }
+        
+        ns_lote[l] = (TiempoActual() - t0) * 1e9 / (fin - b);
+    }
+    
+    return aciertos;
+}
+
+//benchmark de busqueda por id: encadenada, direccionamiento abierto, directorio y busqueda lineal
+//poblacion <= 0 usa los individuos reales; si no, ids sinteticos densos 0..poblacion-1
+//cada carga (uniforme, zipf, fallos) se corre en frio (cache limpia) y en caliente
+void PruebaRendimientoHash(Mapa *grafo, int poblacion){
+    printf("\n========== PRUEBA RENDIMIENTO ==========\n");
+    
+    int reales = (poblacion <= 0);
+    int n = reales ? IDs : poblacion;
+    if(n <= 0){
+        printf("No hay individuos.\n");
+        return;
+    }
+    if(n > MAX_POBLACION_PRUEBA_HASH){
+        printf("Poblacion maxima de prueba: %d\n", MAX_POBLACION_PRUEBA_HASH);
+        return;
+    }
+    
+    //valores: individuos reales o un arreglo pequeno reutilizado (la prueba no los desreferencia)
+    Individuo *relleno = (Individuo*)calloc(64, sizeof(Individuo));
+    EstructurasPrueba ep;
+    ep.n = n;
+    ep.directa = (Individuo**)malloc(n * sizeof(Individuo*));
+    ep.lineal_ids = (int*)malloc(n * sizeof(int));
+    for(int id = 0; id < n; id++){
+        ep.directa[id] = reales ? IndividuoPorID(grafo, id) : &relleno[id & 63];
+        ep.lineal_ids[id] = id;
+    }
+    
+    double t0 = TiempoActual();
+    ep.encadenada = CrearTablaEncadenada(n);
+    ep.abierta = CrearHashTable();
+    ReservarHash(ep.abierta, n);
+    int presentes = 0;
+    for(int id = 0; id < n; id++){
+        if(ep.directa[id] == NULL) continue;
+        InsertarEncadenada(ep.encadenada, id, ep.directa[id]);
+        //se coloca con la clave sintetica (InsertarHash usaria el ID del individuo de relleno)
+        ColocarRanuraHash(ep.abierta, id, ep.directa[id]);
+        presentes++;
+    }
+    double t_construccion = TiempoActual() - t0;
+    
+    //consultas precalculadas: uniformes, zipf (s=1) sobre una permutacion y fallos
+    int num_consultas = CONSULTAS_PRUEBA_HASH;
+    int *consultas[3];
+    const char *cargas[] = {"uniforme", "zipf s=1", "fallos"};
+    unsigned long long estado = 0x9E3779B97F4A7C15ULL;
+    
+    int *permutacion = (int*)malloc(n * sizeof(int));
+    for(int i = 0; i < n; i++){
+        permutacion[i] = i;
+    }
+    for(int i = n - 1; i > 0; i--){
+        int j = (int)(SiguienteXorshift(&estado) % (unsigned long long)(i + 1));
+        int temp = permutacion[i];
+        permutacion[i] = permutacion[j];
+        permutacion[j] = temp;
+    }
+    
+    for(int c = 0; c < 3; c++){
+        consultas[c] = (int*)malloc(num_consultas * sizeof(int));
+    }
+    for(int i = 0; i < num_consultas; i++){
+        consultas[0][i] = (int)(SiguienteXorshift(&estado) % (unsigned long long)n);
+        
+        //inversa continua de la densidad 1/x en [1, n+1]: rango = (n+1)^u - 1
+        double u = (double)(SiguienteXorshift(&estado) >> 11) / 9007199254740992.0;
+        int rango = (int)pow(n + 1.0, u) - 1;
+        if(rango >= n) rango = n - 1;
+        if(rango < 0) rango = 0;
+        consultas[1][i] = permutacion[rango];
+        
+        consultas[2][i] = n + (int)(SiguienteXorshift(&estado) % (unsigned long long)n);
+    }
+    free(permutacion);
+    
+    long tam_limpieza = 64L * 1024 * 1024;
+    unsigned char *limpieza = (unsigned char*)calloc(tam_limpieza, 1);
+    int max_lotes = (num_consultas + LOTE_PRUEBA_HASH - 1) / LOTE_PRUEBA_HASH;
+    double *ns_lote = (double*)malloc(max_lotes * sizeof(double));
+    
+    const char *nombres[] = {"Encadenada", "Abierta (robin hood)", "Directorio", "Busqueda lineal"};
+    double memoria[4];
+    memoria[0] = ep.encadenada->num_cubetas * sizeof(NodoEncadenado*) + (double)presentes * sizeof(NodoEncadenado);
+    memoria[1] = (double)ep.abierta->capacidad * sizeof(RanuraHash);
+    memoria[2] = (double)n * sizeof(Individuo*);
+    memoria[3] = (double)n * (sizeof(int) + sizeof(Individuo*));
+    
+    //la busqueda lineal es o(n) por consulta: se limita el trabajo total
+    int consultas_lineal = (int)(200000000L / n);
+    if(consultas_lineal > num_consultas) consultas_lineal = num_consultas;
+    if(consultas_lineal < LOTE_PRUEBA_HASH) consultas_lineal = LOTE_PRUEBA_HASH;
+    
+    printf("Poblacion: %d (%s) | Presentes: %d\n", n, reales ? "individuos reales" : "ids sinteticos", presentes);
+    printf("Consultas por carga: %d (lineal: %d) | Lotes de %d para percentiles\n",
+           num_consultas, consultas_lineal, LOTE_PRUEBA_HASH);
+    printf("Construccion (encadenada + abierta): %.2f ms\n", t_construccion * 1000.0);
+    
+    printf("\n%-22s %10s\n", "Estructura", "Memoria");
+    printf("-----------------------------------\n");
+    for(int e = 0; e < 4; e++){
+        printf("%-22s %8.2f MB\n", nombres[e], memoria[e] / (1024.0 * 1024.0));
+    }
+    
+    printf("\n%-22s %-9s %-9s %9s %9s %9s %9s %9s\n",
+           "Estructura", "Carga", "Cache", "ns/op", "p50", "p90", "p99", "Aciertos");
+    printf("---------------------------------------------------------------------------------------------\n");
+    
+    volatile int sumidero = 0;
+    for(int e = 0; e < 4; e++){
+        for(int c = 0; c < 3; c++){
+            int num = (e == 3) ? consultas_lineal : num_consultas;
+            int lotes = (num + LOTE_PRUEBA_HASH - 1) / LOTE_PRUEBA_HASH;
+            
+            for(int caliente = 0; caliente <= 1; caliente++){
+                //en frio se limpia la cache; en caliente se repite la misma carga justo despues
+                if(!caliente) LimpiarCachePrueba(limpieza, tam_limpieza);
+                
+                double inicio = TiempoActual();
+                int aciertos = MedirConsultasHash(&ep, e, consultas[c], num, ns_lote);
+                double total = TiempoActual() - inicio;
+                sumidero += aciertos;
+                
+                qsort(ns_lote, lotes, sizeof(double), CompararDouble);
+                printf("%-22s %-9s %-9s %9.1f %9.1f %9.1f %9.1f %8.1f%%\n",
+                       nombres[e], cargas[c], caliente ? "caliente" : "frio",
+                       total * 1e9 / num,
+                       ns_lote[(int)(lotes * 0.50)],
+                       ns_lote[(int)(lotes * 0.90)],
+                       ns_lote[(int)(lotes * 0.99) < lotes ? (int)(lotes * 0.99) : lotes - 1],
+                       aciertos * 100.0 / num);
+            }
+        }
+    }
+    
+    printf("\nns/op incluye el costo de medir cada lote (dos lecturas del reloj por %d consultas).\n", LOTE_PRUEBA_HASH);
+    printf("========================================\n");
+    
+    free(ns_lote);
+    free(limpieza);
+    for(int c = 0; c < 3; c++){
+        free(consultas[c]);
+    }
+    LiberarHashTable(ep.abierta);
+    LiberarTablaEncadenada(ep.encadenada);
+    free(ep.lineal_ids);
+    free(ep.directa);
+    free(relleno);
+}
+
+//=============================================================
+//indice de nombres de individuos - exacto o(|nombre|), prefijo o(|prefijo| + resultados)
+//=============================================================
+
+//copia el nombre en minusculas (ascii) para comparar sin distinguir mayusculas
+void NormalizarNombre(const char *origen, char *destino, int max){
+    int i = 0;
+    for(; origen[i] != '\0' && i < max - 1; i++){
+        char c = origen[i];
+        destino[i] = (c >= 'A' && c <= 'Z') ? c - 'A' + 'a' : c;
+    }
+    destino[i] = '\0';
+}
+
+//fnv-1a con mezcla final (los nombres cortos difieren en pocos bits)
+unsigned int HashNombre(const char *nombre){
+    unsigned int h = 2166136261u;
+    for(const unsigned char *p = (const unsigned char*)nombre; *p != '\0'; p++){
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return FuncionHash((int)h);
+}
+
+//orden por nombre normalizado y luego por id
+int CompararParNombre(const void *a, const void *b){
+    const ParNombre *x = (const ParNombre*)a;
+    const ParNombre *y = (const ParNombre*)b;
+    int c = strcmp(x->clave, y->clave);
+    if(c != 0) return c;
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+//ordena los pares; con openmp cada hilo ordena un bloque y luego se mezclan por rondas
+void OrdenarParesNombre(ParNombre *pares, int n){
+#ifdef _OPENMP
+    int hilos = omp_get_max_threads();
+    if(hilos > 1 && n >= 4096){
+        int bloque = (n + hilos - 1) / hilos;
+        
+        #pragma omp parallel for schedule(static)
+        for(int h = 0; h < hilos; h++){
+            int ini = h * bloque;
+            int fin = (ini + bloque < n) ? ini + bloque : n;
+            if(ini < fin) qsort(pares + ini, fin - ini, sizeof(ParNombre), CompararParNombre);
+        }
+        
+        ParNombre *temp = (ParNombre*)malloc(n * sizeof(ParNombre));
+        ParNombre *origen = pares;
+        ParNombre *destino = temp;
+        for(int ancho = bloque; ancho < n; ancho *= 2){
+            int num_mezclas = (n + 2 * ancho - 1) / (2 * ancho);
+            
+            #pragma omp parallel for schedule(static)
+            for(int m = 0; m < num_mezclas; m++){
+                int ini = m * 2 * ancho;
+                int mitad = (ini + ancho < n) ? ini + ancho : n;
+                int fin = (ini + 2 * ancho < n) ? ini + 2 * ancho : n;
+                int i = ini, j = mitad, k = ini;
+                while(i < mitad && j < fin){
+                    destino[k++] = (CompararParNombre(&origen[j], &origen[i]) < 0) ? origen[j++] : origen[i++];
+                }
+                while(i < mitad) destino[k++] = origen[i++];
+                while(j < fin) destino[k++] = origen[j++];
+            }
+            
+            ParNombre *cambio = origen;
+            origen = destino;
+            destino = cambio;
+        }
+        if(origen != pares){
+            memcpy(pares, origen, n * sizeof(ParNombre));
+        }
+        free(temp);
+        return;
+    }
+#endif
+    qsort(pares, n, sizeof(ParNombre), CompararParNombre);
+}
+
+//arma el trie compacto sobre los nombres ordenados: cada nodo cubre un rango contiguo
+//de nombres y sus hijos quedan contiguos y ordenados por byte (busqueda binaria)
+void ConstruirTriePrefijos(IndiceNombres *indice, int total_caracteres){
+    int max_nodos = total_caracteres + 1;
+    indice->nodos = (NodoPrefijo*)malloc(max_nodos * sizeof(NodoPrefijo));
+    int *profundidad = (int*)malloc(max_nodos * sizeof(int));
+    
+    indice->nodos[0].lo = 0;
+    indice->nodos[0].hi = indice->num_nombres;
+    indice->nodos[0].etiqueta = 0;
+    profundidad[0] = 0;
+    int num_nodos = 1;
+    
+    //en anchura: los hijos de cada nodo se agregan juntos al final del arreglo
+    for(int v = 0; v < num_nodos; v++){
+        NodoPrefijo *nodo = &indice->nodos[v];
+        int d = profundidad[v];
+        int p = nodo->lo;
+        
+        //los nombres que terminan aqui van primero en orden lexicografico
+        while(p < nodo->hi && indice->nombres[p][d] == '\0') p++;
+        
+        nodo->primer_hijo = num_nodos;
+        nodo->num_hijos = 0;
+        while(p < nodo->hi){
+            unsigned char c = (unsigned char)indice->nombres[p][d];
+            int q = p + 1;
+            while(q < nodo->hi && (unsigned char)indice->nombres[q][d] == c) q++;
+            
+            indice->nodos[num_nodos].lo = p;
+            indice->nodos[num_nodos].hi = q;
+            indice->nodos[num_nodos].etiqueta = c;
+            profundidad[num_nodos] = d + 1;
+            num_nodos++;
+            nodo->num_hijos++;
+            p = q;
+        }
+    }
+    
+    indice->num_nodos = num_nodos;
+    free(profundidad);
+}
+
+//construye el indice con los nombres de todos los individuos (ordenamiento en paralelo)
+IndiceNombres* ConstruirIndiceNombres(Mapa *grafo){
+    int n = 0;
+    for(int id = 0; id < IDs; id++){
+        if(IndividuoPorID(grafo, id) != NULL) n++;
+    }
+    
+    int largo_clave = (int)sizeof(((Individuo*)0)->Nombre);
+    IndiceNombres *indice = (IndiceNombres*)malloc(sizeof(IndiceNombres));
+    ParNombre *pares = (ParNombre*)malloc((n > 0 ? n : 1) * sizeof(ParNombre));
+    char *claves = (char*)malloc((long)(n > 0 ? n : 1) * largo_clave);
+    
+    int k = 0;
+    for(int id = 0; id < IDs; id++){
+        if(IndividuoPorID(grafo, id) != NULL) pares[k++].id = id;
+    }
+    
+    #pragma omp parallel for schedule(static)
+    for(int i = 0; i < n; i++){
+        pares[i].clave = claves + (long)i * largo_clave;
+        NormalizarNombre(IndividuoPorID(grafo, pares[i].id)->Nombre, claves + (long)i * largo_clave, largo_clave);
+    }
+    
+    OrdenarParesNombre(pares, n);
+    
+    //nombres distintos internados en un solo bloque + ids agrupados por nombre
+    int distintos = 0;
+    int total_caracteres = 0;
+    for(int i = 0; i < n; i++){
+        if(i == 0 || strcmp(pares[i].clave, pares[i - 1].clave) != 0){
+            distintos++;
+            total_caracteres += (int)strlen(pares[i].clave);
+        }
+    }
+    
+    indice->num_nombres = distintos;
+    indice->num_ids = n;
+    indice->nombres = (char**)malloc((distintos > 0 ? distintos : 1) * sizeof(char*));
+    indice->texto = (char*)malloc(total_caracteres + distintos + 1);
+    indice->inicio = (int*)malloc((distintos + 1) * sizeof(int));
+    indice->ids = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    
+    char *escritura = indice->texto;
+    int u = -1;
+    for(int i = 0; i < n; i++){
+        if(i == 0 || strcmp(pares[i].clave, pares[i - 1].clave) != 0){
+            u++;
+            indice->nombres[u] = escritura;
+            indice->inicio[u] = i;
+            strcpy(escritura, pares[i].clave);
+            escritura += strlen(pares[i].clave) + 1;
+        }
+        indice->ids[i] = pares[i].id;
+    }
+    indice->inicio[distintos] = n;
+    
+    //hash abierto de nombre -> indice del nombre distinto (sondeo lineal, carga <= 1/2)
+    indice->capacidad = 16;
+    while(indice->capacidad < 2 * distintos){
+        indice->capacidad *= 2;
+    }
+    indice->ranuras = (int*)malloc(indice->capacidad * sizeof(int));
+    for(int i = 0; i < indice->capacidad; i++){
+        indice->ranuras[i] = -1;
+    }
+    for(int v = 0; v < distintos; v++){
+        unsigned int pos = HashNombre(indice->nombres[v]) & (unsigned int)(indice->capacidad - 1);
+        while(indice->ranuras[pos] != -1){
+            pos = (pos + 1) & (unsigned int)(indice->capacidad - 1);
+        }
+        indice->ranuras[pos] = v;
+    }
+    
+    ConstruirTriePrefijos(indice, total_caracteres);
+    
+    free(claves);
+    free(pares);
+    return indice;
+}
+
+//ids de todos los individuos con ese nombre (sin distinguir mayusculas)
+//retorna un puntero dentro del indice y deja la cantidad en num_resultados
+const int* BuscarNombreExacto(IndiceNombres *indice, const char *nombre, int *num_resultados){
+    char clave[64];
+    NormalizarNombre(nombre, clave, sizeof(clave));
+    *num_resultados = 0;
+    
+    unsigned int pos = HashNombre(clave) & (unsigned int)(indice->capacidad - 1);
+    while(indice->ranuras[pos] != -1){
+        int v = indice->ranuras[pos];
+        if(strcmp(indice->nombres[v], clave) == 0){
+            *num_resultados = indice->inicio[v + 1] - indice->inicio[v];
+            return indice->ids + indice->inicio[v];
+        }
+        pos = (pos + 1) & (unsigned int)(indice->capacidad - 1);
+    }
+    return NULL;
+}
+
+//ids de todos los individuos cuyo nombre empieza con el prefijo
+//recorre |prefijo| nodos y los resultados quedan contiguos (agrupados por nombre en orden)
+//lo/hi (opcionales) reciben el rango de nombres distintos que coinciden
+const int* BuscarNombrePrefijo(IndiceNombres *indice, const char *prefijo, int *num_resultados, int *lo, int *hi){
+    char clave[64];
+    NormalizarNombre(prefijo, clave, sizeof(clave));
+    *num_resultados = 0;
+    
+    int v = 0;
+    for(const unsigned char *p = (const unsigned char*)clave; *p != '\0'; p++){
+        NodoPrefijo *nodo = &indice->nodos[v];
+        int a = nodo->primer_hijo;
+        int b = nodo->primer_hijo + nodo->num_hijos - 1;
+        int encontrado = -1;
+        while(a <= b){
+            int m = (a + b) / 2;
+            if(indice->nodos[m].etiqueta == *p){
+                encontrado = m;
+                break;
+            }
+            if(indice->nodos[m].etiqueta < *p) a = m + 1;
+            else b = m - 1;
+        }
+        if(encontrado < 0) return NULL;
+        v = encontrado;
+    }
+    
+    NodoPrefijo *nodo = &indice->nodos[v];
+    if(lo != NULL) *lo = nodo->lo;
+    if(hi != NULL) *hi = nodo->hi;
+    *num_resultados = indice->inicio[nodo->hi] - indice->inicio[nodo->lo];
+    return indice->ids + indice->inicio[nodo->lo];
+}
+
+void LiberarIndiceNombres(IndiceNombres *indice){
+    free(indice->nombres);
+    free(indice->texto);
+    free(indice->inicio);
+    free(indice->ids);
+    free(indice->ranuras);
+    free(indice->nodos);
+    free(indice);
+}
+
+//muestra los individuos que coinciden con un nombre exacto o con un prefijo
+void MostrarBusquedaNombre(Mapa *grafo, const char *texto, int por_prefijo){
+    int num = 0;
+    int lo = 0, hi = 0;
+    
+    double inicio = TiempoActual();
+    const int *ids = por_prefijo ? BuscarNombrePrefijo(grafo->indice_nombres, texto, &num, &lo, &hi)
+                                 : BuscarNombreExacto(grafo->indice_nombres, texto, &num);
+    double tiempo = TiempoActual() - inicio;
+    
+    if(ids == NULL || num == 0){
+        printf("\n✗ Ningun individuo coincide con \"%s\"\n", texto);
+        return;
+    }
+    
+    if(por_prefijo){
+        printf("\n✓ %d individuos en %d nombres distintos empiezan con \"%s\"\n", num, hi - lo, texto);
+    } else {
+        printf("\n✓ %d individuos se llaman \"%s\"\n", num, texto);
+    }
+    
+    int limite = num < 25 ? num : 25;
+    printf("\n%-6s %-25s %-15s %-10s\n", "ID", "Nombre", "Territorio", "Estado");
+    printf("------------------------------------------------------------\n");
+    for(int i = 0; i < limite; i++){
+        Individuo *ind = IndividuoPorID(grafo, ids[i]);
+        printf("%-6d %-25s %-15s %-10s\n", ind->ID, ind->Nombre, grafo->territorios[ind->Territorio_ID].Nombre,
+               ind->Infectado ? "INFECTADO" : ind->Recuperado ? "RECUPERADO" : ind->Fallecido ? "FALLECIDO" : "SANO");
+    }
+    if(num > limite){
+        printf("... y %d mas\n", num - limite);
+    }
+    printf("Tiempo de consulta: %.3f us\n", tiempo * 1e6);
+}
+
+//=============================================================
+//rutas criticas de contagio con dijkstra - o((n+m) log n)
+//=============================================================
+
+//reconstruye y muestra la ruta desde origen hasta destino
+//llena ruta[] de origen a destino siguiendo padre[] de forma iterativa, retorna la longitud (0 si no hay ruta)
+int ExtraerRuta(int *padre, int origen, int destino, int *ruta){
+    int longitud = 0;
+    int v = destino;
+    
+    while(v != origen){
+        if(v == -1 || longitud >= NUM_TERRITORIOS - 1) return 0;
+        ruta[longitud++] = v;
+        v = padre[v];
+    }
+    ruta[longitud++] = origen;
+    
+    for(int i = 0; i < longitud / 2; i++){
+        int temp = ruta[i];
+        ruta[i] = ruta[longitud - 1 - i];
+        ruta[longitud - 1 - i] = temp;
+    }
+    return longitud;
+}
+
+void ReconstruirRuta(Mapa *grafo, int origen, int destino, int *padre){
+    int ruta[NUM_TERRITORIOS];
+    int longitud = ExtraerRuta(padre, origen, destino, ruta);
+    
+    if(longitud == 0){
+        printf("(No hay ruta)");
+        return;
+    }
+    
+    for(int i = 0; i < longitud; i++){
+        printf("%s%s", i > 0 ? " -> " : "", grafo->territorios[ruta[i]].Nombre);
+    }
+}
+
+void MostrarRutasCriticas(Mapa *grafo, int origen, float *distancia, int *padre){
+    printf("\n========== RUTAS CRÍTICAS DESDE %s ==========\n", 
+           grafo->territorios[origen].Nombre);
+    
+    printf("\n%-20s %10s %s\n", "Destino", "Distancia", "Ruta");
+    printf("-----------------------------------------------------------\n");
+    
+    // Ordenar destinos por distancia
+    typedef struct {
+        int territorio;
+        float distancia;
+    } DistanciaTerritorio;
+    
+    DistanciaTerritorio destinos[NUM_TERRITORIOS];
+    int num_destinos = 0;
+    
+    for(int v = 0; v < NUM_TERRITORIOS; v++){
+        if(v != origen && distancia[v] < 999999.0){
+            destinos[num_destinos].territorio = v;
+            destinos[num_destinos].distancia = distancia[v];
+            num_destinos++;
+        }
+    }
+    
+    // Ordenar por distancia (insercion, estable)
+    for(int i = 1; i < num_destinos; i++){
+        DistanciaTerritorio actual = destinos[i];
+        int j = i - 1;
+        while(j >= 0 && destinos[j].distancia > actual.distancia){
+            destinos[j+1] = destinos[j];
+            j--;
+        }
+        destinos[j+1] = actual;
+    }
+    
+    // Mostrar todos los destinos alcanzables
+    for(int i = 0; i < num_destinos; i++){
         int v = destinos[i].territorio;
-        printf("  %d. %s (%.3f): ", 
-               rutas_alto_riesgo + 1,
-               grafo->territorios[v].Nombre,
+        printf("%-20s %10.3f  ", 
+               grafo->territorios[v].Nombre, 
                distancia[v]);
         ReconstruirRuta(grafo, origen, v, padre);
         printf("\n");
-        rutas_alto_riesgo++;
-        
-        if(rutas_alto_riesgo >= 5) break; // Mostrar solo top 5
     }
     
-    if(rutas_alto_riesgo == 0){
-        printf("  (Ninguna)\n");
+    // Identificar territorios inalcanzables
+    int inalcanzables = 0;
+    for(int v = 0; v < NUM_TERRITORIOS; v++){
+        if(v != origen && distancia[v] >= 999999.0){
+            inalcanzables++;
+        }
+    }
+    
+    if(inalcanzables > 0){
+        printf("\n⚠ Territorios inalcanzables: %d\n", inalcanzables);
+    }
+    
+    printf("\n============================================================\n");
+    
+    // Análisis de rutas críticas
+    printf("\n--- ANÁLISIS DE RUTAS CRÍTICAS ---\n");
+    
+    // Ruta más corta
+    if(num_destinos > 0){
+        int mas_cercano = destinos[0].territorio;
+        printf("\nTerritorio más cercano:\n");
+        printf("  %s (distancia: %.3f)\n", 
+               grafo->territorios[mas_cercano].Nombre,
+               distancia[mas_cercano]);
+        printf("  Ruta: ");
+        ReconstruirRuta(grafo, origen, mas_cercano, padre);
+        printf("\n");
+    }
+    
+    // Ruta más larga
+    if(num_destinos > 0){
+        int mas_lejano = destinos[num_destinos-1].territorio;
+        printf("\nTerritorio más lejano:\n");
+        printf("  %s (distancia: %.3f)\n", 
+               grafo->territorios[mas_lejano].Nombre,
+               distancia[mas_lejano]);
+        printf("  Ruta: ");
+        ReconstruirRuta(grafo, origen, mas_lejano, padre);
+        printf("\n");
+    }
+    
+    // Rutas de alto riesgo (distancia corta)
+    printf("\nRutas de ALTO RIESGO (distancia < 2.0):\n");
+    int rutas_alto_riesgo = 0;
+    for(int i = 0; i < num_destinos && destinos[i].distancia < 2.0; i++){
+        int v = destinos[i].territorio;
+        printf("  %d. %s (%.3f): ", 
+               rutas_alto_riesgo + 1,
+               grafo->territorios[v].Nombre,
+               distancia[v]);
+        ReconstruirRuta(grafo, origen, v, padre);
+        printf("\n");
+        rutas_alto_riesgo++;
+        
+        if(rutas_alto_riesgo >= 5) break; // Mostrar solo top 5
+    }
+    
+    if(rutas_alto_riesgo == 0){
+        printf("  (Ninguna)\n");
+    }
+    
+    printf("\n===================================\n");
+}
+
+//encuentra las rutas mas cortas desde un territorio usando dijkstra
+void AlgoritmoDijkstra(Mapa *grafo, int territorio_origen){
+    printf("\n========== ALGORITMO DE DIJKSTRA ==========\n");
+    printf("Calculando rutas desde: %s\n", grafo->territorios[territorio_origen].Nombre);
+    
+    if(territorio_origen < 0 || territorio_origen >= NUM_TERRITORIOS){
+        printf("Error: Territorio inválido\n");
+        return;
+    }
+    
+    float *distancia = (float*)malloc(NUM_TERRITORIOS * sizeof(float));
+    int *padre = (int*)malloc(NUM_TERRITORIOS * sizeof(int));
+    
+    AsegurarCSR(grafo);
+    ColaPrioridad *cola = CrearColaPrioridad(ElegirColaPorTamanio(NUM_TERRITORIOS), NUM_TERRITORIOS);
+    
+    DijkstraCSR(NUM_TERRITORIOS, grafo->csr_inicio, grafo->csr_vecino, grafo->csr_peso,
+                territorio_origen, distancia, padre, cola);
+    
+    // Mostrar resultados
+    MostrarRutasCriticas(grafo, territorio_origen, distancia, padre);
+    
+    // Liberar memoria
+    LiberarColaPrioridad(cola);
+    free(distancia);
+    free(padre);
+}
+
+//=============================================================
+//dijkstra y prim genericos sobre csr con cola intercambiable
+//=============================================================
+
+//retorna el backend preferido para un grafo de n vertices
+TipoCola ElegirColaPorTamanio(int n){
+    for(int i = 0; i < NUM_TAMANIOS_COLA; i++){
+        if(n <= tamanios_cola[i]) return cola_por_tamanio[i];
+    }
+    return cola_por_tamanio[NUM_TAMANIOS_COLA - 1];
+}
+
+//dijkstra con distancia 1/proximidad; solo el origen entra al inicio (insercion perezosa)
+void DijkstraCSR(int n, const int *inicio, const int *vecino, const float *peso, int origen,
+                 float *distancia, int *padre, ColaPrioridad *cola){
+    DijkstraMultiFuente(n, inicio, vecino, peso, &origen, 1, distancia, padre, NULL, cola);
+}
+
+//dijkstra sembrado con varias fuentes a distancia 0 en una sola pasada
+//fuente_cercana (opcional) recibe la fuente mas cercana a cada vertice (-1 si no la alcanza)
+void DijkstraMultiFuente(int n, const int *inicio, const int *vecino, const float *peso,
+                         const int *fuentes, int num_fuentes,
+                         float *distancia, int *padre, int *fuente_cercana, ColaPrioridad *cola){
+    for(int i = 0; i < n; i++){
+        distancia[i] = DISTANCIA_INFINITA;
+        padre[i] = -1;
+        if(fuente_cercana != NULL) fuente_cercana[i] = -1;
+    }
+    
+    ReiniciarCola(cola);
+    for(int f = 0; f < num_fuentes; f++){
+        distancia[fuentes[f]] = 0.0;
+        if(fuente_cercana != NULL) fuente_cercana[fuentes[f]] = fuentes[f];
+        ColaInsertarODisminuir(cola, fuentes[f], 0.0);
+    }
+    
+    while(!ColaPrioridadVacia(cola)){
+        int u = ColaExtraerMin(cola).vertice;
+        
+        for(int e = inicio[u]; e < inicio[u + 1]; e++){
+            int v = vecino[e];
+            float nueva_distancia = distancia[u] + 1.0 / peso[e];
+            
+            if(nueva_distancia < distancia[v]){
+                distancia[v] = nueva_distancia;
+                padre[v] = u;
+                if(fuente_cercana != NULL) fuente_cercana[v] = fuente_cercana[u];
+                ColaInsertarODisminuir(cola, v, nueva_distancia);
+            }
+        }
+    }
+}
+
+//llena fuentes[] con los territorios que tienen infectados activos, retorna cuantos son
+int TerritoriosInfectados(Mapa *grafo, int *fuentes){
+    int num_fuentes = 0;
+    
+    for(int t = 0; t < NUM_TERRITORIOS; t++){
+        Territorio *territorio = &grafo->territorios[t];
+        for(int i = 0; i < territorio->num_individuos; i++){
+            if(territorio->individuos[i] != NULL && territorio->individuos[i]->Infectado){
+                fuentes[num_fuentes++] = t;
+                break;
+            }
+        }
+    }
+    
+    return num_fuentes;
+}
+
+//distancia de cada territorio al foco activo mas cercano (dijkstra multi-fuente)
+void DistanciaFocosActivos(Mapa *grafo){
+    printf("\n========== DISTANCIA AL FOCO MAS CERCANO ==========\n");
+    
+    int fuentes[NUM_TERRITORIOS];
+    int num_fuentes = TerritoriosInfectados(grafo, fuentes);
+    
+    if(num_fuentes == 0){
+        printf("No hay territorios con infectados activos.\n");
+        printf("===================================================\n");
+        return;
+    }
+    
+    printf("Focos activos: %d\n", num_fuentes);
+    
+    float distancia[NUM_TERRITORIOS];
+    int padre[NUM_TERRITORIOS];
+    int fuente_cercana[NUM_TERRITORIOS];
+    
+    AsegurarCSR(grafo);
+    ColaPrioridad *cola = CrearColaPrioridad(ElegirColaPorTamanio(NUM_TERRITORIOS), NUM_TERRITORIOS);
+    DijkstraMultiFuente(NUM_TERRITORIOS, grafo->csr_inicio, grafo->csr_vecino, grafo->csr_peso,
+                        fuentes, num_fuentes, distancia, padre, fuente_cercana, cola);
+    LiberarColaPrioridad(cola);
+    
+    //territorios limpios de mas cercano a mas lejano (insercion, estable)
+    int orden[NUM_TERRITORIOS];
+    int num_limpios = 0;
+    for(int t = 0; t < NUM_TERRITORIOS; t++){
+        if(distancia[t] == 0.0) continue;
+        int j = num_limpios - 1;
+        while(j >= 0 && distancia[orden[j]] > distancia[t]){
+            orden[j + 1] = orden[j];
+            j--;
+        }
+        orden[j + 1] = t;
+        num_limpios++;
+    }
+    
+    printf("\n%-20s %-20s %10s  %s\n", "Territorio", "Foco mas cercano", "Distancia", "Ruta desde el foco");
+    printf("---------------------------------------------------------------------------\n");
+    for(int i = 0; i < num_limpios; i++){
+        int t = orden[i];
+        if(fuente_cercana[t] == -1){
+            printf("%-20s %-20s %10s  -\n", grafo->territorios[t].Nombre, "(inalcanzable)", "-");
+            continue;
+        }
+        printf("%-20s %-20s %10.3f  ", grafo->territorios[t].Nombre,
+               grafo->territorios[fuente_cercana[t]].Nombre, distancia[t]);
+        ReconstruirRuta(grafo, fuente_cercana[t], t, padre);
+        printf("\n");
+    }
+    
+    printf("\nFocos:");
+    for(int f = 0; f < num_fuentes; f++){
+        printf(" %s", grafo->territorios[fuentes[f]].Nombre);
+    }
+    printf("\n===================================================\n");
+}
+
+//prim con clave 1 - proximidad; solo alcanza la componente del origen
+//el radix heap exige llaves monotonas, asi que prim lo sustituye por el heap 4-ario
+void PrimCSR(int n, const int *inicio, const int *vecino, const float *peso, int origen,
+             float *clave, int *padre, ColaPrioridad *cola){
+    for(int i = 0; i < n; i++){
+        clave[i] = 999999.0;
+        padre[i] = -1;
+    }
+    
+    ReiniciarCola(cola);
+    clave[origen] = 0.0;
+    ColaInsertarODisminuir(cola, origen, 0.0);
+    
+    while(!ColaPrioridadVacia(cola)){
+        int u = ColaExtraerMin(cola).vertice;
+        
+        for(int e = inicio[u]; e < inicio[u + 1]; e++){
+            int v = vecino[e];
+            float prioridad = 1.0 - peso[e];
+            
+            if(cola->estado[v] != 2 && prioridad < clave[v]){
+                clave[v] = prioridad;
+                padre[v] = u;
+                ColaInsertarODisminuir(cola, v, prioridad);
+            }
+        }
+    }
+}
+
+//genera un grafo aleatorio conexo en formato csr con proximidades en (0.1, 1]
+void GenerarGrafoPruebaCSR(int n, int grado, int **inicio, int **vecino, float **peso){
+    int m = n - 1 + n * grado / 2;
+    int *u = (int*)malloc(m * sizeof(int));
+    int *v = (int*)malloc(m * sizeof(int));
+    float *w = (float*)malloc(m * sizeof(float));
+    
+    //arbol aleatorio para garantizar conexidad y aristas extra al azar
+    for(int i = 0; i < m; i++){
+        if(i < n - 1){
+            u[i] = i + 1;
+            v[i] = rand() % (i + 1);
+        } else {
+            u[i] = rand() % n;
+            v[i] = rand() % n;
+            if(u[i] == v[i]) v[i] = (v[i] + 1) % n;
+        }
+        w[i] = Azar(0.1, 1.0);
+    }
+    
+    *inicio = (int*)calloc(n + 1, sizeof(int));
+    *vecino = (int*)malloc(2 * m * sizeof(int));
+    *peso = (float*)malloc(2 * m * sizeof(float));
+    
+    for(int i = 0; i < m; i++){
+        (*inicio)[u[i] + 1]++;
+        (*inicio)[v[i] + 1]++;
+    }
+    for(int i = 0; i < n; i++){
+        (*inicio)[i + 1] += (*inicio)[i];
+    }
+    
+    int *llenado = (int*)malloc(n * sizeof(int));
+    memcpy(llenado, *inicio, n * sizeof(int));
+    for(int i = 0; i < m; i++){
+        (*vecino)[llenado[u[i]]] = v[i];
+        (*peso)[llenado[u[i]]++] = w[i];
+        (*vecino)[llenado[v[i]]] = u[i];
+        (*peso)[llenado[v[i]]++] = w[i];
+    }
+    
+    free(llenado);
+    free(u);
+    free(v);
+    free(w);
+}
+
+//mide cada backend con dijkstra en grafos de distintos tamanios y guarda el mas rapido
+void CompararColasPrioridad(Mapa *grafo){
+    printf("\n========== COMPARACION DE COLAS DE PRIORIDAD ==========\n");
+    printf("Dijkstra desde varios origenes; tiempo promedio por consulta (us)\n\n");
+    printf("%-9s", "Vertices");
+    for(int t = 0; t < NUM_TIPOS_COLA; t++){
+        printf(" %10s", NombreTipoCola((TipoCola)t));
+    }
+    printf("   Elegida\n");
+    printf("------------------------------------------------------------\n");
+    
+    AsegurarCSR(grafo);
+    
+    for(int c = 0; c < NUM_TAMANIOS_COLA; c++){
+        int n = tamanios_cola[c];
+        int *inicio, *vecino;
+        float *peso;
+        
+        //la primera clase es el mapa real de territorios
+        if(c == 0){
+            inicio = grafo->csr_inicio;
+            vecino = grafo->csr_vecino;
+            peso = grafo->csr_peso;
+        } else {
+            GenerarGrafoPruebaCSR(n, 6, &inicio, &vecino, &peso);
+        }
+        
+        int consultas = n <= NUM_TERRITORIOS ? 20000 : (n <= 1000 ? 500 : (n <= 10000 ? 40 : 5));
+        float *distancia = (float*)malloc(n * sizeof(float));
+        float *referencia = (float*)malloc(n * sizeof(float));
+        int *padre = (int*)malloc(n * sizeof(int));
+        
+        double mejor_tiempo = -1.0;
+        TipoCola mejor = COLA_BINARIA;
+        printf("%-9d", n);
+        
+        for(int t = 0; t < NUM_TIPOS_COLA; t++){
+            ColaPrioridad *cola = CrearColaPrioridad((TipoCola)t, n);
+            int correcto = 1;
+            
+            double t0 = TiempoActual();
+            for(int q = 0; q < consultas; q++){
+                DijkstraCSR(n, inicio, vecino, peso, q % n, distancia, padre, cola);
+            }
+            double tiempo = (TiempoActual() - t0) / consultas;
+            
+            //todas las colas deben dar las mismas distancias que la binaria
+            DijkstraCSR(n, inicio, vecino, peso, 0, distancia, padre, cola);
+            if(t == COLA_BINARIA){
+                memcpy(referencia, distancia, n * sizeof(float));
+            } else {
+                for(int i = 0; i < n; i++){
+                    if(fabs(distancia[i] - referencia[i]) > 1e-3){
+                        correcto = 0;
+                        break;
+                    }
+                }
+            }
+            
+            printf(" %9.2f%s", tiempo * 1e6, correcto ? " " : "!");
+            if(correcto && (mejor_tiempo < 0 || tiempo < mejor_tiempo)){
+                mejor_tiempo = tiempo;
+                mejor = (TipoCola)t;
+            }
+            
+            LiberarColaPrioridad(cola);
+        }
+        
+        cola_por_tamanio[c] = mejor;
+        printf("   %s\n", NombreTipoCola(mejor));
+        
+        free(distancia);
+        free(referencia);
+        free(padre);
+        if(c != 0){
+            free(inicio);
+            free(vecino);
+            free(peso);
+        }
+    }
+    
+    printf("------------------------------------------------------------\n");
+    printf("Dijkstra y Prim usaran la cola elegida segun el numero de vertices.\n");
+    printf("=======================================================\n");
+}
+
+//=============================================================
+//cache de distancias entre todos los pares (floyd-warshall) - o(v^3) una vez
+//=============================================================
+
+//marca la cache de distancias como obsoleta (cambio de topologia o pesos)
+void InvalidarDistancias(Mapa *grafo){
+    grafo->distancias_validas = 0;
+}
+
+//calcula distancias y siguiente salto entre todos los pares de territorios
+//el ciclo interno recorre filas contiguas para que el compilador lo vectorice
+void CalcularDistanciasTodosPares(Mapa *grafo){
+    for(int i = 0; i < NUM_TERRITORIOS; i++){
+        for(int j = 0; j < NUM_TERRITORIOS; j++){
+            if(i == j){
+                grafo->distancias[i][j] = 0.0;
+                grafo->siguiente[i][j] = i;
+            } else if(grafo->matrix[i][j] > 0.0){
+                //mayor proximidad = menor distancia (igual que dijkstra)
+                grafo->distancias[i][j] = 1.0 / grafo->matrix[i][j];
+                grafo->siguiente[i][j] = j;
+            } else {
+                grafo->distancias[i][j] = DISTANCIA_INFINITA;
+                grafo->siguiente[i][j] = -1;
+            }
+        }
+    }
+    
+    for(int k = 0; k < NUM_TERRITORIOS; k++){
+        float *fila_k = grafo->distancias[k];
+        for(int i = 0; i < NUM_TERRITORIOS; i++){
+            float d_ik = grafo->distancias[i][k];
+            if(d_ik >= DISTANCIA_INFINITA) continue;
+            
+            float *fila_i = grafo->distancias[i];
+            int *sig_i = grafo->siguiente[i];
+            int salto = sig_i[k];
+            
+            for(int j = 0; j < NUM_TERRITORIOS; j++){
+                float nueva = d_ik + fila_k[j];
+                int mejora = nueva < fila_i[j];
+                fila_i[j] = mejora ? nueva : fila_i[j];
+                sig_i[j] = mejora ? salto : sig_i[j];
+            }
+        }
+    }
+    
+    grafo->distancias_validas = 1;
+}
+
+//recalcula la cache solo si fue invalidada
+void AsegurarDistancias(Mapa *grafo){
+    if(!grafo->distancias_validas){
+        CalcularDistanciasTodosPares(grafo);
+    }
+}
+
+
+//repara la cache de distancias despues de que la proximidad de a-b paso de peso_anterior al valor actual
+//si la arista se acorta basta una pasada o(v^2) que prueba rutas a traves de ella;
+//si se alarga o desaparece solo se recalculan (con dijkstra) las filas cuyo camino minimo la usaba
+//retorna el numero de pares cuya distancia cambio
+int ActualizarDistanciasArista(Mapa *grafo, int a, int b, float peso_anterior){
+    float largo_anterior = peso_anterior > 0.0 ? 1.0 / peso_anterior : DISTANCIA_INFINITA;
+    float largo = grafo->matrix[a][b] > 0.0 ? 1.0 / grafo->matrix[a][b] : DISTANCIA_INFINITA;
+    int cambios = 0;
+    
+    if(largo == largo_anterior) return 0;
+    
+    //copias de columnas y filas de a y b (se modifican durante la pasada)
+    float col_a[NUM_TERRITORIOS], col_b[NUM_TERRITORIOS];
+    float fila_a[NUM_TERRITORIOS], fila_b[NUM_TERRITORIOS];
+    int salto_a[NUM_TERRITORIOS], salto_b[NUM_TERRITORIOS];
+    for(int i = 0; i < NUM_TERRITORIOS; i++){
+        col_a[i] = grafo->distancias[i][a];
+        col_b[i] = grafo->distancias[i][b];
+        fila_a[i] = grafo->distancias[a][i];
+        fila_b[i] = grafo->distancias[b][i];
+        salto_a[i] = grafo->siguiente[i][a];
+        salto_b[i] = grafo->siguiente[i][b];
+    }
+    
+    if(largo < largo_anterior){
+        for(int i = 0; i < NUM_TERRITORIOS; i++){
+            float *fila_i = grafo->distancias[i];
+            int *sig_i = grafo->siguiente[i];
+            
+            for(int j = 0; j < NUM_TERRITORIOS; j++){
+                float por_ab = col_a[i] + largo + fila_b[j];
+                float por_ba = col_b[i] + largo + fila_a[j];
+                
+                if(por_ab < fila_i[j] && por_ab <= por_ba){
+                    fila_i[j] = por_ab;
+                    sig_i[j] = (i == a) ? b : salto_a[i];
+                    cambios++;
+                } else if(por_ba < fila_i[j]){
+                    fila_i[j] = por_ba;
+                    sig_i[j] = (i == b) ? a : salto_b[i];
+                    cambios++;
+                }
+            }
+        }
+        return cambios;
+    }
+    
+    //la arista empeoro: afecta solo a los origenes para los que era parte de un camino minimo
+    AsegurarCSR(grafo);
+    ColaPrioridad *cola = CrearColaPrioridad(ElegirColaPorTamanio(NUM_TERRITORIOS), NUM_TERRITORIOS);
+    float distancia[NUM_TERRITORIOS];
+    int padre[NUM_TERRITORIOS];
+    
+    for(int i = 0; i < NUM_TERRITORIOS; i++){
+        if(col_a[i] >= DISTANCIA_INFINITA || col_b[i] >= DISTANCIA_INFINITA) continue;
+        int usa_ab = fabs(col_a[i] + largo_anterior - col_b[i]) <= 1e-4;
+        int usa_ba = fabs(col_b[i] + largo_anterior - col_a[i]) <= 1e-4;
+        if(!usa_ab && !usa_ba) continue;
+        
+        DijkstraCSR(NUM_TERRITORIOS, grafo->csr_inicio, grafo->csr_vecino, grafo->csr_peso,
+                    i, distancia, padre, cola);
+        
+        //primer salto desde i: subir por el arbol de dijkstra hasta el hijo de i
+        int salto[NUM_TERRITORIOS];
+        for(int j = 0; j < NUM_TERRITORIOS; j++){
+            if(j == i){
+                salto[j] = i;
+            } else if(padre[j] == -1){
+                salto[j] = -1;
+            } else {
+                int x = j;
+                while(padre[x] != i) x = padre[x];
+                salto[j] = x;
+            }
+        }
+        
+        for(int j = 0; j < NUM_TERRITORIOS; j++){
+            if(grafo->distancias[i][j] != distancia[j]) cambios++;
+            grafo->distancias[i][j] = distancia[j];
+            grafo->siguiente[i][j] = salto[j];
+        }
+    }
+    
+    LiberarColaPrioridad(cola);
+    return cambios;
+}
+
+//aplica un cambio de frontera y compara la reparacion incremental con floyd-warshall completo
+void AplicarCambioFrontera(Mapa *grafo, int t1, int t2, float peso){
+    printf("\n========== CAMBIO DE FRONTERA ==========\n");
+    
+    if(t1 < 0 || t1 >= NUM_TERRITORIOS || t2 < 0 || t2 >= NUM_TERRITORIOS || t1 == t2){
+        printf("Territorios invalidos\n");
+        return;
+    }
+    
+    AsegurarDistancias(grafo);
+    float proximidad_anterior = grafo->matrix[t1][t2];
+    float antes[NUM_TERRITORIOS][NUM_TERRITORIOS];
+    memcpy(antes, grafo->distancias, sizeof(antes));
+    
+    double inicio = TiempoActual();
+    ModificarConexion(grafo, t1, t2, peso);
+    double tiempo_incremental = TiempoActual() - inicio;
+    
+    printf("%s <-> %s: %.3f -> %.3f\n", grafo->territorios[t1].Nombre, grafo->territorios[t2].Nombre,
+           proximidad_anterior, grafo->matrix[t1][t2]);
+    
+    //verificacion contra el recalculo completo
+    float incremental[NUM_TERRITORIOS][NUM_TERRITORIOS];
+    memcpy(incremental, grafo->distancias, sizeof(incremental));
+    
+    inicio = TiempoActual();
+    CalcularDistanciasTodosPares(grafo);
+    double tiempo_completo = TiempoActual() - inicio;
+    
+    int pares_cambiados = 0, pares_distintos = 0;
+    for(int i = 0; i < NUM_TERRITORIOS; i++){
+        for(int j = 0; j < NUM_TERRITORIOS; j++){
+            if(antes[i][j] != incremental[i][j]) pares_cambiados++;
+            if(fabs(incremental[i][j] - grafo->distancias[i][j]) > 1e-3) pares_distintos++;
+        }
+    }
+    
+    printf("Pares con distancia cambiada: %d\n", pares_cambiados);
+    printf("Reparacion incremental: %.2f us | Floyd-Warshall completo: %.2f us\n",
+           tiempo_incremental * 1e6, tiempo_completo * 1e6);
+    printf("Diferencias contra el recalculo: %d\n", pares_distintos);
+    printf("========================================\n");
+}
+
+//distancia minima entre dos territorios desde la cache - o(1)
+float DistanciaTerritorios(Mapa *grafo, int origen, int destino){
+    AsegurarDistancias(grafo);
+    return grafo->distancias[origen][destino];
+}
+
+//llena ruta[] con los territorios de origen a destino - o(longitud de la ruta)
+//retorna la cantidad de territorios en la ruta (0 si no hay ruta)
+int ObtenerRuta(Mapa *grafo, int origen, int destino, int *ruta){
+    AsegurarDistancias(grafo);
+    if(grafo->siguiente[origen][destino] == -1) return 0;
+    
+    int longitud = 0;
+    int actual = origen;
+    ruta[longitud++] = actual;
+    while(actual != destino){
+        actual = grafo->siguiente[actual][destino];
+        ruta[longitud++] = actual;
+    }
+    return longitud;
+}
+
+//muestra las rutas criticas desde origen usando la cache de distancias
+void ConsultarRutasCriticas(Mapa *grafo, int territorio_origen){
+    printf("\n========== RUTAS CRÍTICAS (CACHE) ==========\n");
+    printf("Calculando rutas desde: %s\n", grafo->territorios[territorio_origen].Nombre);
+    
+    if(territorio_origen < 0 || territorio_origen >= NUM_TERRITORIOS){
+        printf("Error: Territorio inválido\n");
+        return;
+    }
+    
+    if(!grafo->distancias_validas){
+        printf("Cache obsoleta, recalculando Floyd-Warshall...\n");
+    }
+    AsegurarDistancias(grafo);
+    
+    //la fila del origen y el salto hacia el origen forman el arbol de rutas
+    float distancia[NUM_TERRITORIOS];
+    int padre[NUM_TERRITORIOS];
+    for(int v = 0; v < NUM_TERRITORIOS; v++){
+        distancia[v] = grafo->distancias[territorio_origen][v];
+        padre[v] = (v == territorio_origen) ? -1 : grafo->siguiente[v][territorio_origen];
+    }
+    
+    MostrarRutasCriticas(grafo, territorio_origen, distancia, padre);
+}
+
+//=============================================================
+//consultas punto a punto con dijkstra bidireccional
+//=============================================================
+
+//crea el espacio de trabajo con una cola por sentido
+EspacioRuta* CrearEspacioRuta(){
+    EspacioRuta *ws = (EspacioRuta*)malloc(sizeof(EspacioRuta));
+    TipoCola tipo = ElegirColaPorTamanio(NUM_TERRITORIOS);
+    ws->cola[0] = CrearColaPrioridad(tipo, NUM_TERRITORIOS);
+    ws->cola[1] = CrearColaPrioridad(tipo, NUM_TERRITORIOS);
+    return ws;
+}
+
+//libera el espacio de trabajo de rutas
+void LiberarEspacioRuta(EspacioRuta *ws){
+    LiberarColaPrioridad(ws->cola[0]);
+    LiberarColaPrioridad(ws->cola[1]);
+    free(ws);
+}
+
+//ruta minima de origen a destino sin imprimir; llena ruta[] y costo, retorna la longitud
+//alterna un paso hacia adelante y uno hacia atras hasta que ninguna ruta pueda mejorar
+int RutaPuntoAPunto(Mapa *grafo, EspacioRuta *ws, int origen, int destino, int *ruta, float *costo){
+    if(origen < 0 || origen >= NUM_TERRITORIOS || destino < 0 || destino >= NUM_TERRITORIOS) return 0;
+    if(origen == destino){
+        ruta[0] = origen;
+        *costo = 0.0;
+        return 1;
+    }
+    
+    int extremo[2] = {origen, destino};
+    float ultima[2] = {0.0, 0.0};
+    for(int lado = 0; lado < 2; lado++){
+        for(int i = 0; i < NUM_TERRITORIOS; i++){
+            ws->distancia[lado][i] = DISTANCIA_INFINITA;
+            ws->padre[lado][i] = -1;
+        }
+        ReiniciarCola(ws->cola[lado]);
+        ws->distancia[lado][extremo[lado]] = 0.0;
+        ColaInsertarODisminuir(ws->cola[lado], extremo[lado], 0.0);
+    }
+    
+    float mejor = DISTANCIA_INFINITA;
+    int encuentro = -1;
+    int lado = 0;
+    
+    while(!ColaPrioridadVacia(ws->cola[0]) && !ColaPrioridadVacia(ws->cola[1])){
+        //ninguna ruta nueva puede costar menos que la suma de los minimos de ambas colas
+        if(ultima[0] + ultima[1] >= mejor) break;
+        
+        NodoHeap nodo = ColaExtraerMin(ws->cola[lado]);
+        int u = nodo.vertice;
+        ultima[lado] = nodo.prioridad;
+        
+        float *dist = ws->distancia[lado];
+        float *dist_otro = ws->distancia[1 - lado];
+        
+        for(int e = grafo->csr_inicio[u]; e < grafo->csr_inicio[u + 1]; e++){
+            int v = grafo->csr_vecino[e];
+            float nueva = dist[u] + 1.0 / grafo->csr_peso[e];
+            
+            if(nueva < dist[v]){
+                dist[v] = nueva;
+                ws->padre[lado][v] = u;
+                ColaInsertarODisminuir(ws->cola[lado], v, nueva);
+            }
+            if(dist[v] + dist_otro[v] < mejor){
+                mejor = dist[v] + dist_otro[v];
+                encuentro = v;
+            }
+        }
+        if(dist[u] + dist_otro[u] < mejor){
+            mejor = dist[u] + dist_otro[u];
+            encuentro = u;
+        }
+        
+        lado = 1 - lado;
+    }
+    
+    if(encuentro == -1) return 0;
+    
+    //mitad del origen (invertida) y luego mitad del destino
+    int longitud = ExtraerRuta(ws->padre[0], origen, encuentro, ruta);
+    for(int v = ws->padre[1][encuentro]; v != -1; v = ws->padre[1][v]){
+        ruta[longitud++] = v;
+    }
+    
+    *costo = mejor;
+    return longitud;
+}
+
+//resuelve un lote de consultas punto a punto en paralelo (un espacio por hilo)
+void RutasPuntoAPuntoLote(Mapa *grafo, ConsultaRuta *consultas, int num_consultas){
+    AsegurarCSR(grafo);
+    
+    #pragma omp parallel
+    {
+        EspacioRuta *ws = CrearEspacioRuta();
+        
+        #pragma omp for schedule(static)
+        for(int q = 0; q < num_consultas; q++){
+            consultas[q].longitud = RutaPuntoAPunto(grafo, ws, consultas[q].origen, consultas[q].destino,
+                                                    consultas[q].ruta, &consultas[q].costo);
+        }
+        
+        LiberarEspacioRuta(ws);
+    }
+}
+
+//muestra la ruta minima entre dos territorios
+void MostrarRutaPuntoAPunto(Mapa *grafo, int origen, int destino){
+    printf("\n========== RUTA PUNTO A PUNTO ==========\n");
+    
+    AsegurarCSR(grafo);
+    EspacioRuta *ws = CrearEspacioRuta();
+    int ruta[NUM_TERRITORIOS];
+    float costo;
+    
+    int longitud = RutaPuntoAPunto(grafo, ws, origen, destino, ruta, &costo);
+    
+    printf("De %s a %s\n", grafo->territorios[origen].Nombre, grafo->territorios[destino].Nombre);
+    if(longitud == 0){
+        printf("(No hay ruta)\n");
+    } else {
+        printf("Distancia: %.3f | Saltos: %d\n", costo, longitud - 1);
+        printf("Ruta: ");
+        for(int i = 0; i < longitud; i++){
+            printf("%s%s", i > 0 ? " -> " : "", grafo->territorios[ruta[i]].Nombre);
+        }
+        printf("\n");
+    }
+    
+    printf("========================================\n");
+    LiberarEspacioRuta(ws);
+}
+
+//mide el rendimiento del lote sobre todos los pares y lo valida contra la cache
+void PruebaRendimientoRutas(Mapa *grafo, int repeticiones){
+    printf("\n========== RENDIMIENTO CONSULTAS PUNTO A PUNTO ==========\n");
+    
+    int num_consultas = NUM_TERRITORIOS * (NUM_TERRITORIOS - 1);
+    ConsultaRuta *consultas = (ConsultaRuta*)malloc(num_consultas * sizeof(ConsultaRuta));
+    
+    int q = 0;
+    for(int a = 0; a < NUM_TERRITORIOS; a++){
+        for(int b = 0; b < NUM_TERRITORIOS; b++){
+            if(a == b) continue;
+            consultas[q].origen = a;
+            consultas[q].destino = b;
+            q++;
+        }
+    }
+    
+    double inicio = TiempoActual();
+    for(int r = 0; r < repeticiones; r++){
+        RutasPuntoAPuntoLote(grafo, consultas, num_consultas);
+    }
+    double tiempo = TiempoActual() - inicio;
+    
+    AsegurarDistancias(grafo);
+    int errores = 0;
+    for(q = 0; q < num_consultas; q++){
+        if(fabs(consultas[q].costo - grafo->distancias[consultas[q].origen][consultas[q].destino]) > 1e-3 &&
+           consultas[q].longitud > 0){
+            errores++;
+        }
+    }
+    
+    double total = (double)num_consultas * repeticiones;
+    printf("Consultas: %.0f (%d pares x %d repeticiones)\n", total, num_consultas, repeticiones);
+    printf("Tiempo total: %.3f ms\n", tiempo * 1000.0);
+    printf("Promedio: %.3f us/consulta (%.0f consultas/s)\n", tiempo * 1e6 / total, total / tiempo);
+    printf("Diferencias contra Floyd-Warshall: %d\n", errores);
+    printf("=========================================================\n");
+    
+    free(consultas);
+}
+
+//=============================================================
+//k rutas mas cortas sin ciclos (yen) sobre dijkstra - o(k v (e + v log v))
+//=============================================================
+
+//crea el espacio de trabajo de yen con su propia cola de prioridad
+EspacioYen* CrearEspacioYen(){
+    EspacioYen *ws = (EspacioYen*)malloc(sizeof(EspacioYen));
+    ws->cola = CrearColaPrioridad(ElegirColaPorTamanio(NUM_TERRITORIOS), NUM_TERRITORIOS);
+    ws->cap_candidatos = 16;
+    ws->num_candidatos = 0;
+    ws->candidatos = (RutaK*)malloc(ws->cap_candidatos * sizeof(RutaK));
+    return ws;
+}
+
+//libera el espacio de trabajo de yen
+void LiberarEspacioYen(EspacioYen *ws){
+    LiberarColaPrioridad(ws->cola);
+    free(ws->candidatos);
+    free(ws);
+}
+
+//bloquea la arista u-v en ambos sentidos del csr
+void BloquearArista(Mapa *grafo, EspacioYen *ws, int u, int v){
+    for(int e = grafo->csr_inicio[u]; e < grafo->csr_inicio[u + 1]; e++){
+        if(grafo->csr_vecino[e] == v) ws->arista_bloqueada[e] = 1;
+    }
+    for(int e = grafo->csr_inicio[v]; e < grafo->csr_inicio[v + 1]; e++){
+        if(grafo->csr_vecino[e] == u) ws->arista_bloqueada[e] = 1;
+    }
+}
+
+//dijkstra que respeta vertices y aristas bloqueados y se detiene al extraer el destino
+//llena ruta[] y retorna su longitud (0 si no hay ruta)
+int DijkstraRestringido(Mapa *grafo, EspacioYen *ws, int origen, int destino, int *ruta){
+    ColaPrioridad *cola = ws->cola;
+    
+    for(int i = 0; i < NUM_TERRITORIOS; i++){
+        ws->distancia[i] = DISTANCIA_INFINITA;
+        ws->padre[i] = -1;
+    }
+    
+    ReiniciarCola(cola);
+    ws->distancia[origen] = 0.0;
+    ColaInsertarODisminuir(cola, origen, 0.0);
+    
+    while(!ColaPrioridadVacia(cola)){
+        int u = ColaExtraerMin(cola).vertice;
+        if(u == destino) break;
+        
+        for(int e = grafo->csr_inicio[u]; e < grafo->csr_inicio[u + 1]; e++){
+            int v = grafo->csr_vecino[e];
+            if(ws->arista_bloqueada[e] || ws->vertice_bloqueado[v]) continue;
+            
+            float nueva_distancia = ws->distancia[u] + 1.0 / grafo->csr_peso[e];
+            if(nueva_distancia < ws->distancia[v]){
+                ws->distancia[v] = nueva_distancia;
+                ws->padre[v] = u;
+                ColaInsertarODisminuir(cola, v, nueva_distancia);
+            }
+        }
+    }
+    
+    if(ws->distancia[destino] >= DISTANCIA_INFINITA) return 0;
+    
+    //reconstruir de atras hacia adelante
+    int longitud = 0;
+    for(int v = destino; v != -1; v = ws->padre[v]){
+        ruta[longitud++] = v;
+    }
+    for(int i = 0; i < longitud / 2; i++){
+        int temp = ruta[i];
+        ruta[i] = ruta[longitud - 1 - i];
+        ruta[longitud - 1 - i] = temp;
+    }
+    return longitud;
+}
+
+//agrega una ruta candidata en orden de costo, descartando duplicados
+void AgregarCandidatoYen(EspacioYen *ws, RutaK *ruta){
+    for(int c = 0; c < ws->num_candidatos; c++){
+        if(ws->candidatos[c].longitud == ruta->longitud &&
+           memcmp(ws->candidatos[c].nodos, ruta->nodos, ruta->longitud * sizeof(int)) == 0){
+            return;
+        }
+    }
+    
+    if(ws->num_candidatos == ws->cap_candidatos){
+        ws->cap_candidatos *= 2;
+        ws->candidatos = (RutaK*)realloc(ws->candidatos, ws->cap_candidatos * sizeof(RutaK));
+    }
+    
+    int i = ws->num_candidatos++;
+    while(i > 0 && ws->candidatos[i - 1].costo > ruta->costo){
+        ws->candidatos[i] = ws->candidatos[i - 1];
+        i--;
+    }
+    ws->candidatos[i] = *ruta;
+}
+
+//calcula hasta k rutas sin ciclos de origen a destino en orden de costo
+//requiere csr y cache de distancias vigentes (la cache sirve de cota inferior para podar)
+int KRutasMasCortas(Mapa *grafo, int origen, int destino, int k, RutaK *rutas, EspacioYen *ws){
+    if(k <= 0 || origen == destino) return 0;
+    
+    memset(ws->vertice_bloqueado, 0, sizeof(ws->vertice_bloqueado));
+    memset(ws->arista_bloqueada, 0, sizeof(ws->arista_bloqueada));
+    ws->num_candidatos = 0;
+    
+    rutas[0].longitud = DijkstraRestringido(grafo, ws, origen, destino, rutas[0].nodos);
+    if(rutas[0].longitud == 0) return 0;
+    rutas[0].costo = ws->distancia[destino];
+    
+    int encontradas = 1;
+    RutaK spur;
+    
+    while(encontradas < k){
+        RutaK *previa = &rutas[encontradas - 1];
+        float costo_raiz = 0.0;
+        
+        for(int i = 0; i < previa->longitud - 1; i++){
+            int nodo_spur = previa->nodos[i];
+            if(i > 0){
+                costo_raiz += 1.0 / grafo->matrix[previa->nodos[i - 1]][nodo_spur];
+            }
+            
+            //poda: si ya hay suficientes candidatos mas baratos que la cota inferior, saltar
+            int faltan = k - encontradas;
+            if(ws->num_candidatos >= faltan &&
+               ws->candidatos[faltan - 1].costo <= costo_raiz + grafo->distancias[nodo_spur][destino]){
+                continue;
+            }
+            
+            memset(ws->vertice_bloqueado, 0, sizeof(ws->vertice_bloqueado));
+            memset(ws->arista_bloqueada, 0, sizeof(ws->arista_bloqueada));
+            
+            //bloquear la siguiente arista de toda ruta ya elegida que comparta la raiz
+            for(int r = 0; r < encontradas; r++){
+                if(rutas[r].longitud > i + 1 &&
+                   memcmp(rutas[r].nodos, previa->nodos, (i + 1) * sizeof(int)) == 0){
+                    BloquearArista(grafo, ws, rutas[r].nodos[i], rutas[r].nodos[i + 1]);
+                }
+            }
+            //la raiz no puede repetirse (rutas sin ciclos)
+            for(int j = 0; j < i; j++){
+                ws->vertice_bloqueado[previa->nodos[j]] = 1;
+            }
+            
+            int longitud_spur = DijkstraRestringido(grafo, ws, nodo_spur, destino, spur.nodos + i);
+            if(longitud_spur == 0) continue;
+            
+            memcpy(spur.nodos, previa->nodos, i * sizeof(int));
+            spur.longitud = i + longitud_spur;
+            spur.costo = costo_raiz + ws->distancia[destino];
+            AgregarCandidatoYen(ws, &spur);
+        }
+        
+        if(ws->num_candidatos == 0) break;
+        
+        //la candidata mas barata pasa a ser la siguiente ruta
+        rutas[encontradas++] = ws->candidatos[0];
+        ws->num_candidatos--;
+        memmove(ws->candidatos, ws->candidatos + 1, ws->num_candidatos * sizeof(RutaK));
+    }
+    
+    return encontradas;
+}
+
+//imprime una ruta como lista de territorios
+void ImprimirRutaK(Mapa *grafo, RutaK *ruta){
+    for(int i = 0; i < ruta->longitud; i++){
+        printf("%s%s", i > 0 ? " -> " : "", grafo->territorios[ruta->nodos[i]].Nombre);
+    }
+}
+
+//muestra las k rutas alternativas mas cortas entre dos territorios
+void MostrarKRutas(Mapa *grafo, int origen, int destino, int k){
+    printf("\n========== %d RUTAS MAS CORTAS ==========\n", k);
+    printf("De %s a %s\n\n", grafo->territorios[origen].Nombre, grafo->territorios[destino].Nombre);
+    
+    AsegurarCSR(grafo);
+    AsegurarDistancias(grafo);
+    
+    RutaK *rutas = (RutaK*)malloc(k * sizeof(RutaK));
+    EspacioYen *ws = CrearEspacioYen();
+    
+    int encontradas = KRutasMasCortas(grafo, origen, destino, k, rutas, ws);
+    
+    if(encontradas == 0){
+        printf("(No hay ruta)\n");
+    }
+    for(int r = 0; r < encontradas; r++){
+        printf("%2d. [%.3f] ", r + 1, rutas[r].costo);
+        ImprimirRutaK(grafo, &rutas[r]);
+        printf("\n");
+    }
+    if(encontradas > 0 && encontradas < k){
+        printf("\nSolo existen %d rutas sin ciclos\n", encontradas);
+    }
+    
+    printf("\n=========================================\n");
+    
+    LiberarEspacioYen(ws);
+    free(rutas);
+}
+
+//resuelve un lote de consultas de k rutas en paralelo (un espacio de trabajo por hilo)
+void KRutasLote(Mapa *grafo, ConsultaKRutas *consultas, int num_consultas){
+    //csr y cache se preparan antes para que los hilos solo lean el grafo
+    AsegurarCSR(grafo);
+    AsegurarDistancias(grafo);
+    
+    #pragma omp parallel
+    {
+        EspacioYen *ws = CrearEspacioYen();
+        
+        #pragma omp for schedule(dynamic, 4)
+        for(int q = 0; q < num_consultas; q++){
+            consultas[q].encontradas = KRutasMasCortas(grafo, consultas[q].origen, consultas[q].destino,
+                                                       consultas[q].k, consultas[q].rutas, ws);
+        }
+        
+        LiberarEspacioYen(ws);
+    }
+}
+
+//calcula k rutas para todos los pares y reporta los pares con alternativas mas parejas
+void AnalizarKRutasTodosPares(Mapa *grafo, int k){
+    printf("\n========== K RUTAS EN LOTE (TODOS LOS PARES) ==========\n");
+    
+    int num_consultas = NUM_TERRITORIOS * (NUM_TERRITORIOS - 1) / 2;
+    ConsultaKRutas *consultas = (ConsultaKRutas*)malloc(num_consultas * sizeof(ConsultaKRutas));
+    RutaK *rutas = (RutaK*)malloc(num_consultas * k * sizeof(RutaK));
+    
+    int q = 0;
+    for(int a = 0; a < NUM_TERRITORIOS; a++){
+        for(int b = a + 1; b < NUM_TERRITORIOS; b++){
+            consultas[q].origen = a;
+            consultas[q].destino = b;
+            consultas[q].k = k;
+            consultas[q].rutas = rutas + q * k;
+            consultas[q].encontradas = 0;
+            q++;
+        }
+    }
+    
+    double inicio = TiempoActual();
+    KRutasLote(grafo, consultas, num_consultas);
+    double tiempo = TiempoActual() - inicio;
+    
+    int total_rutas = 0;
+    for(q = 0; q < num_consultas; q++){
+        total_rutas += consultas[q].encontradas;
+    }
+    
+    printf("Consultas: %d | K: %d | Rutas encontradas: %d\n", num_consultas, k, total_rutas);
+    printf("Tiempo total: %.3f ms\n", tiempo * 1000.0);
+    
+    //pares cuya k-esima ruta cuesta casi lo mismo que la primera: dificiles de contener
+    int mostrados = 0;
+    int *usado = (int*)calloc(num_consultas, sizeof(int));
+    
+    printf("\nPares con alternativas mas parejas (costo ruta %d / ruta 1):\n", k);
+    while(mostrados < 10){
+        int mejor = -1;
+        float mejor_razon = 0.0;
+        for(q = 0; q < num_consultas; q++){
+            if(usado[q] || consultas[q].encontradas < k) continue;
+            float razon = consultas[q].rutas[k - 1].costo / consultas[q].rutas[0].costo;
+            if(mejor == -1 || razon < mejor_razon){
+                mejor = q;
+                mejor_razon = razon;
+            }
+        }
+        if(mejor == -1) break;
+        
+        usado[mejor] = 1;
+        mostrados++;
+        printf("  %2d. %-20s <-> %-20s %.3f\n", mostrados,
+               grafo->territorios[consultas[mejor].origen].Nombre,
+               grafo->territorios[consultas[mejor].destino].Nombre,
+               mejor_razon);
+    }
+    if(mostrados == 0){
+        printf("  (Ningun par tiene %d rutas)\n", k);
+    }
+    
+    printf("=======================================================\n");
+    
+    free(usado);
+    free(rutas);
+    free(consultas);
+}
+
+
+//=============================================================
+//centralidad de intermediacion (brandes) - o(v e) exacta, o(s e) muestreada
+//=============================================================
+
+//construye la red de contactos en csr a partir de las listas de cada individuo
+RedContactos* ConstruirRedContactos(Mapa *grafo){
+    RedContactos *red = (RedContactos*)malloc(sizeof(RedContactos));
+    red->n = IDs;
+    red->inicio = (int*)calloc(red->n + 1, sizeof(int));
+    red->por_id = (Individuo**)calloc(red->n, sizeof(Individuo*));
+    
+    for(int v = 0; v < red->n; v++){
+        Individuo *ind = IndividuoPorID(grafo, v);
+        if(ind == NULL) continue;
+        red->por_id[v] = ind;
+        red->inicio[v + 1] = ind->Grado;
+    }
+    for(int v = 0; v < red->n; v++){
+        red->inicio[v + 1] += red->inicio[v];
+    }
+    
+    red->vecino = (int*)malloc((red->inicio[red->n] > 0 ? red->inicio[red->n] : 1) * sizeof(int));
+    red->prob = (float*)malloc((red->inicio[red->n] > 0 ? red->inicio[red->n] : 1) * sizeof(float));
+    
+    for(int v = 0; v < red->n; v++){
+        if(red->por_id[v] == NULL) continue;
+        int e = red->inicio[v];
+        for(Contacto *c = red->por_id[v]->contactos; c != NULL; c = c->sgt){
+            red->vecino[e] = c->v_individuo;
+            red->prob[e] = c->prob_contagio;
+            e++;
+        }
+    }
+    
+    return red;
+}
+
+//libera la red de contactos en csr
+void LiberarRedContactos(RedContactos *red){
+    free(red->inicio);
+    free(red->vecino);
+    free(red->prob);
+    free(red->por_id);
+    free(red);
+}
+
+//crea el espacio de trabajo de brandes (ponderado usa cola de prioridad)
+EspacioBrandes* CrearEspacioBrandes(int n, int ponderado){
+    EspacioBrandes *ws = (EspacioBrandes*)malloc(sizeof(EspacioBrandes));
+    ws->distancia = (float*)malloc(n * sizeof(float));
+    ws->sigma = (double*)malloc(n * sizeof(double));
+    ws->delta = (double*)malloc(n * sizeof(double));
+    ws->orden = (int*)malloc(n * sizeof(int));
+    ws->centralidad = (double*)calloc(n, sizeof(double));
+    ws->cola = ponderado ? CrearColaPrioridad(ElegirColaPorTamanio(n), n) : NULL;
+    return ws;
+}
+
+//libera el espacio de trabajo de brandes
+void LiberarEspacioBrandes(EspacioBrandes *ws){
+    free(ws->distancia);
+    free(ws->sigma);
+    free(ws->delta);
+    free(ws->orden);
+    free(ws->centralidad);
+    if(ws->cola != NULL) LiberarColaPrioridad(ws->cola);
+    free(ws);
+}
+
+//una fuente de brandes: caminos minimos (bfs o dijkstra con 1/peso) y acumulacion de dependencias
+//los predecesores se recalculan al acumular para no guardar listas
+void AcumularBrandes(int n, const int *inicio, const int *vecino, const float *peso, int fuente, EspacioBrandes *ws){
+    float *dist = ws->distancia;
+    double *sigma = ws->sigma;
+    double *delta = ws->delta;
+    int num_orden = 0;
+    
+    for(int i = 0; i < n; i++){
+        dist[i] = DISTANCIA_INFINITA;
+        sigma[i] = 0.0;
+        delta[i] = 0.0;
+    }
+    dist[fuente] = 0.0;
+    sigma[fuente] = 1.0;
+    
+    if(peso == NULL){
+        //bfs: el arreglo orden sirve tambien de cola
+        int frente = 0;
+        ws->orden[num_orden++] = fuente;
+        while(frente < num_orden){
+            int u = ws->orden[frente++];
+            for(int e = inicio[u]; e < inicio[u + 1]; e++){
+                int v = vecino[e];
+                if(dist[v] >= DISTANCIA_INFINITA){
+                    dist[v] = dist[u] + 1.0;
+                    ws->orden[num_orden++] = v;
+                }
+                if(dist[v] == dist[u] + 1.0){
+                    sigma[v] += sigma[u];
+                }
+            }
+        }
+    } else {
+        ReiniciarCola(ws->cola);
+        ColaInsertarODisminuir(ws->cola, fuente, 0.0);
+        while(!ColaPrioridadVacia(ws->cola)){
+            int u = ColaExtraerMin(ws->cola).vertice;
+            ws->orden[num_orden++] = u;
+            for(int e = inicio[u]; e < inicio[u + 1]; e++){
+                int v = vecino[e];
+                float nueva = dist[u] + 1.0 / peso[e];
+                if(nueva < dist[v] - 1e-5){
+                    dist[v] = nueva;
+                    sigma[v] = sigma[u];
+                    ColaInsertarODisminuir(ws->cola, v, nueva);
+                } else if(fabs(nueva - dist[v]) <= 1e-5){
+                    sigma[v] += sigma[u];
+                }
+            }
+        }
+    }
+    
+    //acumular dependencias en orden inverso de distancia
+    for(int i = num_orden - 1; i > 0; i--){
+        int w = ws->orden[i];
+        double coef = (1.0 + delta[w]) / sigma[w];
+        for(int e = inicio[w]; e < inicio[w + 1]; e++){
+            int v = vecino[e];
+            float largo = (peso == NULL) ? 1.0 : 1.0 / peso[e];
+            if(fabs(dist[v] + largo - dist[w]) <= 1e-5){
+                delta[v] += sigma[v] * coef;
+            }
+        }
+        ws->centralidad[w] += delta[w];
+    }
+}
+
+//centralidad de intermediacion sobre un grafo no dirigido en csr
+//peso NULL = no ponderado; fuentes NULL = exacta (todas), si no se escala por n / num_fuentes
+void CentralidadBrandes(int n, const int *inicio, const int *vecino, const float *peso,
+                        const int *fuentes, int num_fuentes, double *centralidad){
+    int total_fuentes = (fuentes == NULL) ? n : num_fuentes;
+    
+    for(int v = 0; v < n; v++){
+        centralidad[v] = 0.0;
+    }
+    
+    #pragma omp parallel
+    {
+        EspacioBrandes *ws = CrearEspacioBrandes(n, peso != NULL);
+        
+        #pragma omp for schedule(dynamic, 8)
+        for(int f = 0; f < total_fuentes; f++){
+            int fuente = (fuentes == NULL) ? f : fuentes[f];
+            AcumularBrandes(n, inicio, vecino, peso, fuente, ws);
+        }
+        
+        #pragma omp critical
+        for(int v = 0; v < n; v++){
+            centralidad[v] += ws->centralidad[v];
+        }
+        
+        LiberarEspacioBrandes(ws);
+    }
+    
+    //cada par se cuenta desde ambos extremos en un grafo no dirigido
+    double escala = 0.5 * ((double)n / total_fuentes);
+    for(int v = 0; v < n; v++){
+        centralidad[v] *= escala;
+    }
+}
+
+//ranking de territorios por intermediacion (distancia 1/proximidad)
+void CentralidadTerritorios(Mapa *grafo){
+    printf("\n========== CENTRALIDAD DE INTERMEDIACION: TERRITORIOS ==========\n");
+    
+    AsegurarCSR(grafo);
+    double centralidad[NUM_TERRITORIOS];
+    
+    double inicio = TiempoActual();
+    CentralidadBrandes(NUM_TERRITORIOS, grafo->csr_inicio, grafo->csr_vecino, grafo->csr_peso,
+                       NULL, 0, centralidad);
+    double tiempo = TiempoActual() - inicio;
+    
+    //ordenar por centralidad descendente (insercion, n pequeno)
+    int orden[NUM_TERRITORIOS];
+    for(int i = 0; i < NUM_TERRITORIOS; i++){
+        int j = i - 1;
+        while(j >= 0 && centralidad[orden[j]] < centralidad[i]){
+            orden[j + 1] = orden[j];
+            j--;
+        }
+        orden[j + 1] = i;
+    }
+    
+    double pares = (NUM_TERRITORIOS - 1) * (NUM_TERRITORIOS - 2) / 2.0;
+    printf("\n%-4s %-20s %12s %12s %8s\n", "#", "Territorio", "Intermed.", "Normalizada", "Grado");
+    printf("----------------------------------------------------------------\n");
+    for(int i = 0; i < NUM_TERRITORIOS; i++){
+        int t = orden[i];
+        printf("%-4d %-20s %12.2f %12.4f %8d\n", i + 1, grafo->territorios[t].Nombre,
+               centralidad[t], centralidad[t] / pares,
+               grafo->csr_inicio[t + 1] - grafo->csr_inicio[t]);
+    }
+    
+    printf("\nPuntos de estrangulamiento (cerrar primero):");
+    for(int i = 0; i < 3 && centralidad[orden[i]] > 0.0; i++){
+        printf(" %s", grafo->territorios[orden[i]].Nombre);
+    }
+    printf("\nTiempo: %.3f ms\n", tiempo * 1000.0);
+    printf("================================================================\n");
+}
+
+//ranking de individuos por intermediacion en la red de contactos
+//num_muestras <= 0 o >= n calcula la version exacta
+void CentralidadIndividuos(Mapa *grafo, int num_muestras){
+    printf("\n========== CENTRALIDAD DE INTERMEDIACION: INDIVIDUOS ==========\n");
+    
+    RedContactos *red = ConstruirRedContactos(grafo);
+    int n = red->n;
+    double *centralidad = (double*)malloc(n * sizeof(double));
+    int *fuentes = NULL;
+    
+    if(num_muestras > 0 && num_muestras < n){
+        //muestreo sin reemplazo con fisher-yates parcial
+        int *ids = (int*)malloc(n * sizeof(int));
+        for(int v = 0; v < n; v++){
+            ids[v] = v;
+        }
+        for(int i = 0; i < num_muestras; i++){
+            int j = i + rand() % (n - i);
+            int temp = ids[i];
+            ids[i] = ids[j];
+            ids[j] = temp;
+        }
+        fuentes = ids;
+        printf("Aproximacion por muestreo: %d de %d fuentes\n", num_muestras, n);
+    } else {
+        num_muestras = n;
+        printf("Calculo exacto: %d fuentes\n", n);
+    }
+    
+    double inicio = TiempoActual();
+    CentralidadBrandes(n, red->inicio, red->vecino, NULL, fuentes, num_muestras, centralidad);
+    double tiempo = TiempoActual() - inicio;
+    
+    IndividuoOrden *lista = (IndividuoOrden*)malloc(n * sizeof(IndividuoOrden));
+    int total = 0;
+    for(int v = 0; v < n; v++){
+        if(red->por_id[v] == NULL) continue;
+        lista[total].individuo = red->por_id[v];
+        lista[total].valor_orden = centralidad[v];
+        total++;
+    }
+    
+    int k = total < 15 ? total : 15;
+    SeleccionarTopK(lista, total, k);
+    
+    printf("\n%-4s %-6s %-25s %-15s %12s %6s\n", "#", "ID", "Nombre", "Territorio", "Intermed.", "Grado");
+    printf("-------------------------------------------------------------------------\n");
+    for(int i = 0; i < k; i++){
+        Individuo *ind = lista[i].individuo;
+        printf("%-4d %-6d %-25s %-15s %12.1f %6d\n", i + 1, ind->ID, ind->Nombre,
+               grafo->territorios[ind->Territorio_ID].Nombre, lista[i].valor_orden, ind->Grado);
+    }
+    
+    printf("\nEstos individuos conectan la mayor cantidad de caminos minimos;\n");
+    printf("aislarlos o vacunarlos corta la red de contagio.\n");
+    printf("Tiempo: %.3f ms\n", tiempo * 1000.0);
+    printf("===============================================================\n");
+    
+    free(lista);
+    free(fuentes);
+    free(centralidad);
+    LiberarRedContactos(red);
+}
+
+//=============================================================
+//cadenas de contagio entre individuos - union-find sobre contactos o(e alfa(n))
+//=============================================================
+
+//devuelve todos los elementos a conjuntos individuales sin reservar memoria
+void ReiniciarUnionFind(UnionFind *uf){
+    for(int i = 0; i < uf->n; i++){
+        uf->padre[i] = i;
+        uf->rango[i] = 0;
+    }
+}
+
+//une en uf a los infectados conectados por algun contacto y retorna el numero de cadenas
+//con openmp las aristas se reparten en bloques contiguos: cada hilo arma un bosque local
+//y solo las aristas que unieron algo localmente (a lo sumo n-1) pasan al union-find global
+int CalcularCadenasContagio(RedContactos *red, const unsigned char *infectado, UnionFind *uf){
+    int n = red->n;
+    int uniones = 0;
+    
+    ReiniciarUnionFind(uf);
+    
+#ifdef _OPENMP
+    int num_aristas = red->inicio[n];
+    int hilos = omp_get_max_threads();
+    if(hilos > 1 && num_aristas >= 4096){
+        #pragma omp parallel reduction(+:uniones)
+        {
+            int h = omp_get_thread_num();
+            int num_h = omp_get_num_threads();
+            int ini = (int)((long)num_aristas * h / num_h);
+            int fin = (int)((long)num_aristas * (h + 1) / num_h);
+            
+            UnionFind *local = CrearUnionFind(n);
+            int *bosque = (int*)malloc(2 * n * sizeof(int));
+            int num_bosque = 0;
+            
+            //vertice dueno de la primera arista del bloque (busqueda binaria en inicio)
+            int lo = 0, hi = n - 1;
+            while(lo < hi){
+                int mid = (lo + hi + 1) / 2;
+                if(red->inicio[mid] <= ini) lo = mid;
+                else hi = mid - 1;
+            }
+            
+            int u = lo;
+            for(int e = ini; e < fin; e++){
+                while(red->inicio[u + 1] <= e) u++;
+                int v = red->vecino[e];
+                if(infectado[u] && infectado[v] && UnirUF(local, u, v)){
+                    bosque[num_bosque++] = u;
+                    bosque[num_bosque++] = v;
+                }
+            }
+            
+            #pragma omp critical
+            {
+                for(int i = 0; i < num_bosque; i += 2){
+                    uniones += UnirUF(uf, bosque[i], bosque[i + 1]);
+                }
+            }
+            
+            free(bosque);
+            LiberarUnionFind(local);
+        }
+    } else
+#endif
+    {
+        for(int u = 0; u < n; u++){
+            if(!infectado[u]) continue;
+            for(int e = red->inicio[u]; e < red->inicio[u + 1]; e++){
+                if(infectado[red->vecino[e]]){
+                    uniones += UnirUF(uf, u, red->vecino[e]);
+                }
+            }
+        }
+    }
+    
+    int infectados = 0;
+    for(int v = 0; v < n; v++){
+        infectados += infectado[v] ? 1 : 0;
+    }
+    return infectados - uniones;
+}
+
+//tamanio de la cadena mas grande (tamanio[] de n enteros como espacio de trabajo)
+int MayorCadenaContagio(UnionFind *uf, const unsigned char *infectado, int *tamanio){
+    int mayor = 0;
+    memset(tamanio, 0, uf->n * sizeof(int));
+    for(int v = 0; v < uf->n; v++){
+        if(!infectado[v]) continue;
+        int r = EncontrarUF(uf, v);
+        tamanio[r]++;
+        if(tamanio[r] > mayor) mayor = tamanio[r];
+    }
+    return mayor;
+}
+
+//recalcula las cadenas de contagio del dia a partir de la tabla dp
+void TomarSnapshotCadenas(TablaDP *dp, int dia){
+    memset(dp->infectado_id, 0, dp->red->n);
+    for(int i = 0; i < dp->num_individuos; i++){
+        if(dp->tabla[dia][i].estado == ESTADO_INFECTADO){
+            dp->infectado_id[dp->individuos_lista[i]->ID] = 1;
+        }
+    }
+    
+    dp->brotes[dia].cadenas = CalcularCadenasContagio(dp->red, dp->infectado_id, dp->uf_cadenas);
+    dp->brotes[dia].mayor_cadena = MayorCadenaContagio(dp->uf_cadenas, dp->infectado_id, dp->tamanio_cadena);
+}
+
+//reporte de cadenas de contagio con los infectados actuales
+//distribucion de tamanios y, para las mas grandes, territorio dominante y mezcla de cepas
+void MostrarCadenasContagio(Mapa *grafo){
+    printf("\n========== CADENAS DE CONTAGIO ENTRE INDIVIDUOS ==========\n");
+    
+    RedContactos *red = ConstruirRedContactos(grafo);
+    int n = red->n;
+    unsigned char *infectado = (unsigned char*)calloc(n, sizeof(unsigned char));
+    for(int v = 0; v < n; v++){
+        infectado[v] = (red->por_id[v] != NULL && red->por_id[v]->Infectado) ? 1 : 0;
+    }
+    
+    UnionFind *uf = CrearUnionFind(n);
+    double inicio_t = TiempoActual();
+    int num_cadenas = CalcularCadenasContagio(red, infectado, uf);
+    double tiempo = TiempoActual() - inicio_t;
+    
+    if(num_cadenas <= 0){
+        printf("\nNo hay individuos infectados.\n");
+        printf("==========================================================\n");
+        LiberarUnionFind(uf);
+        free(infectado);
+        LiberarRedContactos(red);
+        return;
+    }
+    
+    //agrupar miembros por cadena (conteo por raiz + suma de prefijos)
+    int *cadena_de = (int*)malloc(n * sizeof(int));
+    int *tamanio = (int*)calloc(num_cadenas, sizeof(int));
+    int *raiz_cadena = (int*)malloc(n * sizeof(int));
+    int siguiente = 0;
+    for(int v = 0; v < n; v++){
+        raiz_cadena[v] = -1;
+    }
+    for(int v = 0; v < n; v++){
+        if(!infectado[v]) continue;
+        int r = EncontrarUF(uf, v);
+        if(raiz_cadena[r] < 0) raiz_cadena[r] = siguiente++;
+        cadena_de[v] = raiz_cadena[r];
+        tamanio[cadena_de[v]]++;
+    }
+    
+    int *inicio = (int*)calloc(num_cadenas + 1, sizeof(int));
+    for(int c = 0; c < num_cadenas; c++){
+        inicio[c + 1] = inicio[c] + tamanio[c];
+    }
+    int *miembros = (int*)malloc(inicio[num_cadenas] * sizeof(int));
+    int *pos = (int*)malloc(num_cadenas * sizeof(int));
+    memcpy(pos, inicio, num_cadenas * sizeof(int));
+    for(int v = 0; v < n; v++){
+        if(infectado[v]) miembros[pos[cadena_de[v]]++] = v;
+    }
+    
+    //distribucion de tamanios
+    int limites[] = {1, 2, 5, 10, 25, 50};
+    const char *etiquetas[] = {"1", "2-4", "5-9", "10-24", "25-49", "50+"};
+    int num_rangos = 6;
+    int histograma[6] = {0};
+    int mayor = 0;
+    for(int c = 0; c < num_cadenas; c++){
+        int r = num_rangos - 1;
+        while(tamanio[c] < limites[r]) r--;
+        histograma[r]++;
+        if(tamanio[c] > mayor) mayor = tamanio[c];
+    }
+    
+    printf("Infectados: %d | Cadenas: %d | Mayor cadena: %d\n", inicio[num_cadenas], num_cadenas, mayor);
+    printf("\nDistribucion de tamanios:\n");
+    for(int r = 0; r < num_rangos; r++){
+        printf("  %-6s: %5d cadenas\n", etiquetas[r], histograma[r]);
+    }
+    
+    //cadenas mas grandes (seleccion parcial por tamanio, empates por orden de aparicion)
+    int top = num_cadenas < 10 ? num_cadenas : 10;
+    int *orden = (int*)malloc(num_cadenas * sizeof(int));
+    for(int c = 0; c < num_cadenas; c++){
+        orden[c] = c;
+    }
+    for(int i = 0; i < top; i++){
+        int mejor = i;
+        for(int j = i + 1; j < num_cadenas; j++){
+            if(tamanio[orden[j]] > tamanio[orden[mejor]]) mejor = j;
+        }
+        int elegido = orden[mejor];
+        for(int j = mejor; j > i; j--){
+            orden[j] = orden[j - 1];
+        }
+        orden[i] = elegido;
+    }
+    
+    printf("\n%-4s %7s  %-25s %s\n", "#", "Tamanio", "Territorio dominante", "Cepas");
+    printf("------------------------------------------------------------------------\n");
+    for(int i = 0; i < top; i++){
+        int c = orden[i];
+        int por_territorio[NUM_TERRITORIOS] = {0};
+        int por_cepa[NUM_CEPAS] = {0};
+        
+        for(int k = inicio[c]; k < inicio[c + 1]; k++){
+            Individuo *ind = red->por_id[miembros[k]];
+            por_territorio[ind->Territorio_ID]++;
+            if(ind->Cepa_ID >= 0 && ind->Cepa_ID < NUM_CEPAS) por_cepa[ind->Cepa_ID]++;
+        }
+        
+        int terr_mayor = 0;
+        for(int t = 1; t < NUM_TERRITORIOS; t++){
+            if(por_territorio[t] > por_territorio[terr_mayor]) terr_mayor = t;
+        }
+        
+        char dominante[48];
+        snprintf(dominante, sizeof(dominante), "%s (%d)", grafo->territorios[terr_mayor].Nombre, por_territorio[terr_mayor]);
+        printf("%-4d %7d  %-25s", i + 1, tamanio[c], dominante);
+        
+        //hasta 3 cepas con mas miembros
+        for(int m = 0; m < 3; m++){
+            int mejor = -1;
+            for(int k = 0; k < NUM_CEPAS; k++){
+                if(por_cepa[k] > 0 && (mejor < 0 || por_cepa[k] > por_cepa[mejor])) mejor = k;
+            }
+            if(mejor < 0) break;
+            printf("%s%s (%d)", m == 0 ? " " : ", ", grafo->cepas[mejor].Nombre, por_cepa[mejor]);
+            por_cepa[mejor] = 0;
+        }
+        printf("\n");
+    }
+    
+    printf("\nTiempo union-find: %.3f ms\n", tiempo * 1000.0);
+    printf("==========================================================\n");
+    
+    free(orden);
+    free(pos);
+    free(miembros);
+    free(inicio);
+    free(raiz_cadena);
+    free(tamanio);
+    free(cadena_de);
+    LiberarUnionFind(uf);
+    free(infectado);
+    LiberarRedContactos(red);
+}
+
+//=============================================================
+//componentes conexas de la red de contactos (afforest) - o(n + e) paralelo
+//=============================================================
+
+//une los arboles de u y v colgando la raiz mayor de la menor (cas, sin bloqueos)
+void EnlazarComponentes(int *comp, int u, int v){
+    int p1 = comp[u];
+    int p2 = comp[v];
+    
+    while(p1 != p2){
+        int alto = p1 > p2 ? p1 : p2;
+        int bajo = p1 + p2 - alto;
+        int p_alto = comp[alto];
+        
+        if(p_alto == bajo) break;
+        if(p_alto == alto && __sync_bool_compare_and_swap(&comp[alto], alto, bajo)) break;
+        
+        p1 = comp[comp[alto]];
+        p2 = comp[bajo];
+    }
+}
+
+//aplana los arboles para que cada vertice apunte directo a su raiz
+void ComprimirComponentes(int n, int *comp){
+    #pragma omp parallel for schedule(static, 2048)
+    for(int v = 0; v < n; v++){
+        while(comp[v] != comp[comp[v]]){
+            comp[v] = comp[comp[v]];
+        }
+    }
+}
+
+//afforest: enlaza primero unos pocos vecinos por vertice, estima la componente gigante
+//por muestreo y solo recorre el resto de aristas de los vertices que quedaron fuera
+//al terminar comp[v] es el menor id de su componente; retorna el numero de componentes
+int ComponentesAfforest(int n, const int *inicio, const int *vecino, int *comp){
+    int rondas = 2;
+    
+    #pragma omp parallel for schedule(static)
+    for(int v = 0; v < n; v++){
+        comp[v] = v;
+    }
+    
+    //fase 1: muestreo de vecinos (las primeras aristas de cada vertice)
+    for(int r = 0; r < rondas; r++){
+        #pragma omp parallel for schedule(dynamic, 2048)
+        for(int u = 0; u < n; u++){
+            if(inicio[u] + r < inicio[u + 1]){
+                EnlazarComponentes(comp, u, vecino[inicio[u] + r]);
+            }
+        }
+        ComprimirComponentes(n, comp);
+    }
+    
+    //fase 2: componente mas frecuente en una muestra (generador propio, no toca rand())
+    int num_muestras = 1024;
+    int *muestra = (int*)malloc(num_muestras * sizeof(int));
+    unsigned int semilla = 2463534242u;
+    for(int i = 0; i < num_muestras; i++){
+        semilla ^= semilla << 13;
+        semilla ^= semilla >> 17;
+        semilla ^= semilla << 5;
+        muestra[i] = comp[semilla % (unsigned int)n];
+    }
+    
+    //moda de la muestra ordenandola (insercion, la muestra es pequena)
+    for(int i = 1; i < num_muestras; i++){
+        int x = muestra[i];
+        int j = i - 1;
+        while(j >= 0 && muestra[j] > x){
+            muestra[j + 1] = muestra[j];
+            j--;
+        }
+        muestra[j + 1] = x;
+    }
+    int gigante = muestra[0];
+    int mejor = 0;
+    for(int i = 0; i < num_muestras; ){
+        int j = i;
+        while(j < num_muestras && muestra[j] == muestra[i]) j++;
+        if(j - i > mejor){
+            mejor = j - i;
+            gigante = muestra[i];
+        }
+        i = j;
+    }
+    free(muestra);
+    
+    //fase 3: aristas restantes, omitiendo los vertices que ya estan en la gigante
+    //(la red es simetrica: cualquier arista hacia la gigante la ve su otro extremo)
+    #pragma omp parallel for schedule(dynamic, 2048)
+    for(int u = 0; u < n; u++){
+        if(comp[u] == gigante) continue;
+        for(int e = inicio[u] + rondas; e < inicio[u + 1]; e++){
+            EnlazarComponentes(comp, u, vecino[e]);
+        }
     }
+    ComprimirComponentes(n, comp);
     
-    printf("\n===================================\n");
+    int num_componentes = 0;
+    #pragma omp parallel for reduction(+:num_componentes) schedule(static)
+    for(int v = 0; v < n; v++){
+        if(comp[v] == v) num_componentes++;
+    }
+    return num_componentes;
 }
 
-//encuentra las rutas mas cortas desde un territorio usando dijkstra
-void AlgoritmoDijkstra(Mapa *grafo, int territorio_origen){
-    printf("\n========== ALGORITMO DE DIJKSTRA ==========\n");
-    printf("Calculando rutas desde: %s\n", grafo->territorios[territorio_origen].Nombre);
-    
-    if(territorio_origen < 0 || territorio_origen >= NUM_TERRITORIOS){
-        printf("Error: Territorio inválido\n");
-        return;
+//calcula las componentes de la red de contactos con ids compactos 0..k-1
+//(numeradas por el menor id de individuo que contienen)
+ComponentesRed* CalcularComponentesRed(RedContactos *red){
+    ComponentesRed *cc = (ComponentesRed*)malloc(sizeof(ComponentesRed));
+    int n = red->n;
+    cc->n = n;
+    cc->componente = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    cc->num_componentes = ComponentesAfforest(n, red->inicio, red->vecino, cc->componente);
+    cc->tamanio = (int*)calloc(cc->num_componentes > 0 ? cc->num_componentes : 1, sizeof(int));
+    
+    //la raiz es el menor id, asi que se numera antes que cualquier otro miembro
+    int siguiente = 0;
+    for(int v = 0; v < n; v++){
+        int raiz = cc->componente[v];
+        cc->componente[v] = (raiz == v) ? siguiente++ : cc->componente[raiz];
+        cc->tamanio[cc->componente[v]]++;
+    }
+    
+    return cc;
+}
+
+//id de la componente de un individuo (-1 si el id no existe)
+int ComponenteDeIndividuo(ComponentesRed *cc, int id){
+    if(id < 0 || id >= cc->n) return -1;
+    return cc->componente[id];
+}
+
+//libera las componentes de la red
+void LiberarComponentesRed(ComponentesRed *cc){
+    free(cc->componente);
+    free(cc->tamanio);
+    free(cc);
+}
+
+//reporte de conectividad de toda la red de contactos
+//cuanta poblacion es alcanzable desde los infectados y que componentes atender primero
+void MostrarComponentesRed(Mapa *grafo){
+    printf("\n========== COMPONENTES CONEXAS DE LA RED DE CONTACTOS ==========\n");
+    
+    RedContactos *red = ConstruirRedContactos(grafo);
+    double inicio_t = TiempoActual();
+    ComponentesRed *cc = CalcularComponentesRed(red);
+    double tiempo = TiempoActual() - inicio_t;
+    int k = cc->num_componentes;
+    
+    int *infectados = (int*)calloc(k > 0 ? k : 1, sizeof(int));
+    int *susceptibles = (int*)calloc(k > 0 ? k : 1, sizeof(int));
+    int poblacion = 0;
+    int aislados = 0;
+    int mayor = -1;
+    
+    for(int v = 0; v < red->n; v++){
+        Individuo *ind = red->por_id[v];
+        if(ind == NULL) continue;
+        int c = cc->componente[v];
+        poblacion++;
+        if(ind->Grado == 0) aislados++;
+        if(ind->Infectado) infectados[c]++;
+        else if(!ind->Recuperado && !ind->Fallecido) susceptibles[c]++;
+        if(mayor < 0 || cc->tamanio[c] > cc->tamanio[mayor]) mayor = c;
+    }
+    
+    int alcanzable = 0;
+    int con_focos = 0;
+    for(int c = 0; c < k; c++){
+        if(infectados[c] > 0){
+            alcanzable += cc->tamanio[c];
+            con_focos++;
+        }
     }
     
-    // Inicialización
-    float *distancia = (float*)malloc(NUM_TERRITORIOS * sizeof(float));
-    int *padre = (int*)malloc(NUM_TERRITORIOS * sizeof(int));
-    int *visitado = (int*)malloc(NUM_TERRITORIOS * sizeof(int));
+    printf("Individuos: %d | Contactos: %d | Componentes: %d\n", poblacion, red->inicio[red->n] / 2, k);
+    if(mayor >= 0){
+        printf("Componente gigante: #%d con %d individuos (%.1f%%)\n", mayor, cc->tamanio[mayor],
+               100.0 * cc->tamanio[mayor] / (poblacion > 0 ? poblacion : 1));
+    }
+    printf("Individuos aislados: %d\n", aislados);
+    printf("Poblacion alcanzable desde los focos: %d (%.1f%%) en %d componentes\n", alcanzable,
+           100.0 * alcanzable / (poblacion > 0 ? poblacion : 1), con_focos);
     
-    for(int i = 0; i < NUM_TERRITORIOS; i++){
-        distancia[i] = 999999.0; // Infinito
-        padre[i] = -1;
-        visitado[i] = 0;
+    //componentes con infectados ordenadas por susceptibles expuestos (objetivo de intervencion)
+    if(con_focos > 0){
+        int *orden = (int*)malloc(con_focos * sizeof(int));
+        int m = 0;
+        for(int c = 0; c < k; c++){
+            if(infectados[c] > 0) orden[m++] = c;
+        }
+        for(int i = 1; i < m; i++){
+            int x = orden[i];
+            int j = i - 1;
+            while(j >= 0 && susceptibles[orden[j]] < susceptibles[x]){
+                orden[j + 1] = orden[j];
+                j--;
+            }
+            orden[j + 1] = x;
+        }
+        
+        int top = m < 10 ? m : 10;
+        printf("\nComponentes a intervenir (con infectados, por susceptibles expuestos):\n");
+        printf("%-10s %8s %10s %12s\n", "Componente", "Tamanio", "Infectados", "Susceptibles");
+        printf("------------------------------------------------\n");
+        for(int i = 0; i < top; i++){
+            int c = orden[i];
+            printf("#%-9d %8d %10d %12d\n", c, cc->tamanio[c], infectados[c], susceptibles[c]);
+        }
+        free(orden);
     }
     
-    distancia[territorio_origen] = 0.0;
+    printf("\nTiempo afforest: %.3f ms\n", tiempo * 1000.0);
+    printf("================================================================\n");
     
-    // Crear MinHeap
-    MinHeap *heap = CrearMinHeap(NUM_TERRITORIOS);
+    free(susceptibles);
+    free(infectados);
+    LiberarComponentesRed(cc);
+    LiberarRedContactos(red);
+}
+
+//compara afforest contra union-find secuencial en una red aleatoria grande
+//n individuos con grado promedio cercano a grado (red simetrica en csr)
+void PruebaComponentesRed(int n, int grado){
+    printf("\n========== RENDIMIENTO: COMPONENTES CONEXAS ==========\n");
     
-    for(int v = 0; v < NUM_TERRITORIOS; v++){
-        InsertarHeap(heap, v, distancia[v]);
+    if(n < 2 || grado < 1){
+        printf("Parametros invalidos.\n");
+        return;
     }
     
-    // Algoritmo de Dijkstra
-    int vertices_procesados = 0;
-    
-    while(!EstaVacio(heap) && vertices_procesados < NUM_TERRITORIOS){
-        NodoHeap min_nodo = ExtraerMin(heap);
-        int u = min_nodo.vertice;
-        
-        if(u == -1 || distancia[u] >= 999999.0) break;
-        
-        visitado[u] = 1;
-        vertices_procesados++;
-        
-        // Relajar aristas adyacentes
-        for(int v = 0; v < NUM_TERRITORIOS; v++){
-            if(!visitado[v] && grafo->matrix[u][v] > 0.0){
-                // Convertir proximidad a distancia
-                // Mayor proximidad = menor distancia
-                float peso_arista = 1.0 / grafo->matrix[u][v];
-                
-                float nueva_distancia = distancia[u] + peso_arista;
-                
-                if(nueva_distancia < distancia[v]){
-                    distancia[v] = nueva_distancia;
-                    padre[v] = u;
-                    DisminuirClave(heap, v, nueva_distancia);
-                }
-            }
-        }
+    long num_pares = (long)n * grado / 2;
+    long num_aristas = num_pares * 2;
+    if(num_aristas > 2000000000L){
+        printf("Red demasiado grande para indices de 32 bits.\n");
+        return;
     }
     
-    // Mostrar resultados
-    MostrarRutasCriticas(grafo, territorio_origen, distancia, padre);
+    int *origen = (int*)malloc(num_pares * sizeof(int));
+    int *destino = (int*)malloc(num_pares * sizeof(int));
+    int *inicio = (int*)calloc(n + 1, sizeof(int));
+    int *vecino = (int*)malloc(num_aristas * sizeof(int));
+    int *comp = (int*)malloc(n * sizeof(int));
+    if(origen == NULL || destino == NULL || inicio == NULL || vecino == NULL || comp == NULL){
+        printf("Memoria insuficiente.\n");
+        free(origen); free(destino); free(inicio); free(vecino); free(comp);
+        return;
+    }
     
-    // Liberar memoria
-    LiberarHeap(heap);
-    free(distancia);
-    free(padre);
-    free(visitado);
+    //pares aleatorios con xorshift (no altera la secuencia de rand())
+    unsigned long long x = 88172645463325252ULL;
+    for(long i = 0; i < num_pares; i++){
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        origen[i] = (int)(x % (unsigned long long)n);
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        destino[i] = (int)(x % (unsigned long long)n);
+        inicio[origen[i] + 1]++;
+        inicio[destino[i] + 1]++;
+    }
+    for(int v = 0; v < n; v++){
+        inicio[v + 1] += inicio[v];
+    }
+    int *pos = (int*)malloc(n * sizeof(int));
+    memcpy(pos, inicio, n * sizeof(int));
+    for(long i = 0; i < num_pares; i++){
+        vecino[pos[origen[i]]++] = destino[i];
+        vecino[pos[destino[i]]++] = origen[i];
+    }
+    free(pos);
+    
+    int hilos = 1;
+#ifdef _OPENMP
+    hilos = omp_get_max_threads();
+#endif
+    printf("Individuos: %d | Aristas (csr): %ld | Hilos: %d\n", n, num_aristas, hilos);
+    
+    double t0 = TiempoActual();
+    int k_afforest = ComponentesAfforest(n, inicio, vecino, comp);
+    double t_afforest = TiempoActual() - t0;
+    
+    t0 = TiempoActual();
+    UnionFind *uf = CrearUnionFind(n);
+    int uniones = 0;
+    for(long i = 0; i < num_pares; i++){
+        uniones += UnirUF(uf, origen[i], destino[i]);
+    }
+    double t_uf = TiempoActual() - t0;
+    int k_uf = n - uniones;
+    
+    //misma particion: cada vertice comparte raiz uf con su etiqueta afforest
+    int coincide = (k_afforest == k_uf);
+    for(int v = 0; v < n && coincide; v++){
+        coincide = (EncontrarUF(uf, v) == EncontrarUF(uf, comp[v]));
+    }
+    
+    printf("\n%-28s %12s %14s\n", "Algoritmo", "Tiempo (ms)", "Componentes");
+    printf("------------------------------------------------------\n");
+    printf("%-28s %12.2f %14d\n", "Union-find secuencial", t_uf * 1000.0, k_uf);
+    printf("%-28s %12.2f %14d\n", "Afforest (paralelo)", t_afforest * 1000.0, k_afforest);
+    printf("\nAceleracion: %.2fx | Resultados %s\n", t_afforest > 0 ? t_uf / t_afforest : 0.0,
+           coincide ? "coinciden" : "NO coinciden");
+    printf("======================================================\n");
+    
+    LiberarUnionFind(uf);
+    free(comp);
+    free(vecino);
+    free(inicio);
+    free(destino);
+    free(origen);
 }
 
 //=============================================================
-//clustering de cepas usando trie - o(n*l) construccion, o(l) busqueda
+//clustering de cepas usando trie radix - o(l) insercion y busqueda
+//aristas comprimidas sobre el alfabeto completo de bytes, nodos en un arreglo contiguo
 //=============================================================
 
-int CharAIndice(char c){
-    if(c >= 'a' && c <= 'z'){
-        return c - 'a';
-    }
-    if(c >= 'A' && c <= 'Z'){
-        return c - 'A';
-    }
-    return -1; // Caracter no válido
+//agrega un nodo al arreglo (los indices siguen validos aunque el arreglo se mueva)
+int NuevoNodoTrie(Trie *trie, int etiqueta, int largo, int cepa_id){
+    if(trie->num_nodos == trie->capacidad_nodos){
+        trie->capacidad_nodos *= 2;
+        trie->nodos = (NodoTrie*)realloc(trie->nodos, trie->capacidad_nodos * sizeof(NodoTrie));
+    }
+    int v = trie->num_nodos++;
+    NodoTrie *nodo = &trie->nodos[v];
+    nodo->etiqueta = etiqueta;
+    nodo->largo = largo;
+    nodo->primer_hijo = -1;
+    nodo->hermano = -1;
+    nodo->cepa_id = cepa_id;
+    nodo->primer_byte = largo > 0 ? (unsigned char)trie->texto[etiqueta] : 0;
+    return v;
 }
 
-//crea un nuevo nodo vacio para el trie
-NodoTrie* CrearNodoTrie(){
-    NodoTrie *nodo = (NodoTrie*)malloc(sizeof(NodoTrie));
-    nodo->es_final = 0;
-    nodo->cepa_id = -1;
-    
-    for(int i = 0; i < ALPHABET_SIZE; i++){
-        nodo->hijos[i] = NULL;
+//guarda bytes en el texto del trie y retorna su posicion
+int GuardarTextoTrie(Trie *trie, const char *bytes, int largo){
+    while(trie->largo_texto + largo > trie->capacidad_texto){
+        trie->capacidad_texto *= 2;
+        trie->texto = (char*)realloc(trie->texto, trie->capacidad_texto);
     }
-    
-    return nodo;
+    int posicion = trie->largo_texto;
+    memcpy(trie->texto + posicion, bytes, largo);
+    trie->largo_texto += largo;
+    return posicion;
 }
 
-//crea un nuevo trie vacio
+//crea un nuevo trie vacio (solo la raiz)
 Trie* CrearTrie(){
     Trie *trie = (Trie*)malloc(sizeof(Trie));
-    trie->raiz = CrearNodoTrie();
+    trie->capacidad_nodos = 64;
+    trie->nodos = (NodoTrie*)malloc(trie->capacidad_nodos * sizeof(NodoTrie));
+    trie->num_nodos = 0;
+    trie->capacidad_texto = 256;
+    trie->texto = (char*)malloc(trie->capacidad_texto);
+    trie->largo_texto = 0;
     trie->num_palabras = 0;
+    trie->cantidad_subarbol = NULL;
+    trie->suma_contagio = NULL;
+    trie->suma_mortalidad = NULL;
+    trie->agregados_listos = 0;
+    NuevoNodoTrie(trie, 0, 0, -1);
     return trie;
 }
 
-//inserta una palabra en el trie asociada a un id de cepa
+//hijo de v cuya etiqueta empieza con c (-1 si no hay); anterior recibe el hermano previo
+//los hijos estan ordenados por primer byte, asi que la busqueda se corta al pasarse
+int HijoTrie(Trie *trie, int v, unsigned char c, int *anterior){
+    int previo = -1;
+    int h = trie->nodos[v].primer_hijo;
+    while(h >= 0 && trie->nodos[h].primer_byte < c){
+        previo = h;
+        h = trie->nodos[h].hermano;
+    }
+    if(anterior != NULL) *anterior = previo;
+    return (h >= 0 && trie->nodos[h].primer_byte == c) ? h : -1;
+}
+
+//inserta una palabra en el trie asociada a un id de cepa (sin distinguir mayusculas)
+//si la palabra diverge a mitad de una arista, la arista se parte en dos
 void InsertarEnTrie(Trie *trie, const char *palabra, int cepa_id){
-    NodoTrie *actual = trie->raiz;
-    
-    for(int i = 0; palabra[i] != '\0'; i++){
-        int indice = CharAIndice(palabra[i]);
+    char clave[LARGO_CLAVE_TRIE];
+    NormalizarNombre(palabra, clave, sizeof(clave));
+    int largo = (int)strlen(clave);
+    int v = 0;
+    int i = 0;
+    trie->agregados_listos = 0;
+    
+    while(i < largo){
+        unsigned char c = (unsigned char)clave[i];
+        int anterior;
+        int h = HijoTrie(trie, v, c, &anterior);
+        
+        if(h < 0){
+            //hoja nueva con el resto de la palabra, enlazada en orden entre los hermanos
+            int etiqueta = GuardarTextoTrie(trie, clave + i, largo - i);
+            int hoja = NuevoNodoTrie(trie, etiqueta, largo - i, cepa_id);
+            if(anterior < 0){
+                trie->nodos[hoja].hermano = trie->nodos[v].primer_hijo;
+                trie->nodos[v].primer_hijo = hoja;
+            } else {
+                trie->nodos[hoja].hermano = trie->nodos[anterior].hermano;
+                trie->nodos[anterior].hermano = hoja;
+            }
+            trie->num_palabras++;
+            return;
+        }
         
-        // Saltar caracteres especiales (-, números, espacios)
-        if(indice == -1) continue;
+        //bytes en comun entre la etiqueta y el resto de la palabra
+        int k = 0;
+        while(k < trie->nodos[h].largo && i + k < largo &&
+              trie->texto[trie->nodos[h].etiqueta + k] == clave[i + k]){
+            k++;
+        }
         
-        if(actual->hijos[indice] == NULL){
-            actual->hijos[indice] = CrearNodoTrie();
+        if(k < trie->nodos[h].largo){
+            //partir: el nodo medio toma los k bytes comunes y h cuelga de el con el resto
+            int medio = NuevoNodoTrie(trie, trie->nodos[h].etiqueta, k, -1);
+            NodoTrie *nh = &trie->nodos[h];
+            trie->nodos[medio].primer_hijo = h;
+            trie->nodos[medio].hermano = nh->hermano;
+            nh->etiqueta += k;
+            nh->largo -= k;
+            nh->primer_byte = (unsigned char)trie->texto[nh->etiqueta];
+            nh->hermano = -1;
+            if(anterior < 0) trie->nodos[v].primer_hijo = medio;
+            else trie->nodos[anterior].hermano = medio;
+            h = medio;
         }
         
-        actual = actual->hijos[indice];
+        v = h;
+        i += k;
     }
     
-    actual->es_final = 1;
-    actual->cepa_id = cepa_id;
-    trie->num_palabras++;
+    if(trie->nodos[v].cepa_id < 0) trie->num_palabras++;
+    trie->nodos[v].cepa_id = cepa_id;
 }
 
-//busca una palabra en el trie y retorna el id de cepa si existe
-int BuscarEnTrie(Trie *trie, const char *palabra){
-    NodoTrie *actual = trie->raiz;
-    
-    for(int i = 0; palabra[i] != '\0'; i++){
-        int indice = CharAIndice(palabra[i]);
+//baja por el trie siguiendo la clave; retorna el nodo donde termina (-1 si se sale)
+//fin_arista queda en 1 si la clave termina justo al final de la etiqueta de ese nodo
+int DescenderTrie(Trie *trie, const char *clave, int *fin_arista){
+    int largo = (int)strlen(clave);
+    int v = 0;
+    int i = 0;
+    *fin_arista = 1;
+    
+    while(i < largo){
+        int h = HijoTrie(trie, v, (unsigned char)clave[i], NULL);
+        if(h < 0) return -1;
         
-        if(indice == -1) continue;
-        
-        if(actual->hijos[indice] == NULL){
-            return -1; // No encontrado
+        NodoTrie *nodo = &trie->nodos[h];
+        int k = 0;
+        while(k < nodo->largo && i + k < largo && trie->texto[nodo->etiqueta + k] == clave[i + k]){
+            k++;
         }
+        if(i + k < largo && k < nodo->largo) return -1;
         
-        actual = actual->hijos[indice];
-    }
-    
-    if(actual != NULL && actual->es_final){
-        return actual->cepa_id;
+        *fin_arista = (k == nodo->largo);
+        v = h;
+        i += k;
     }
+    return v;
+}
+
+//busca una palabra en el trie y retorna el id de cepa si existe
+int BuscarEnTrie(Trie *trie, const char *palabra){
+    char clave[LARGO_CLAVE_TRIE];
+    NormalizarNombre(palabra, clave, sizeof(clave));
     
-    return -1;
+    int fin_arista;
+    int v = DescenderTrie(trie, clave, &fin_arista);
+    if(v < 0 || !fin_arista) return -1;
+    return trie->nodos[v].cepa_id;
 }
 
-void BuscarPorPrefijoRecursivo(NodoTrie *nodo, char *prefijo_actual, int nivel, 
-                                Mapa *grafo, int *resultados, int *num_resultados){
-    if(nodo == NULL) return;
+//recorre el subarbol en preorden (orden lexicografico) juntando ids de cepa
+void RecolectarCepasTrie(Trie *trie, int v, int *resultados, int *num_resultados, int max_resultados){
+    if(*num_resultados >= max_resultados) return;
     
-    if(nodo->es_final && *num_resultados < 50){
-        resultados[*num_resultados] = nodo->cepa_id;
-        (*num_resultados)++;
+    if(trie->nodos[v].cepa_id >= 0){
+        resultados[(*num_resultados)++] = trie->nodos[v].cepa_id;
     }
-    
-    for(int i = 0; i < ALPHABET_SIZE; i++){
-        if(nodo->hijos[i] != NULL){
-            prefijo_actual[nivel] = 'a' + i;
-            prefijo_actual[nivel + 1] = '\0';
-            
-            BuscarPorPrefijoRecursivo(nodo->hijos[i], prefijo_actual, 
-                                     nivel + 1, grafo, resultados, num_resultados);
-        }
+    for(int h = trie->nodos[v].primer_hijo; h >= 0; h = trie->nodos[h].hermano){
+        RecolectarCepasTrie(trie, h, resultados, num_resultados, max_resultados);
     }
 }
 
@@ -2505,36 +7494,32 @@ void BuscarPorPrefijoRecursivo(NodoTrie *nodo, char *prefijo_actual, int nivel,
 void BuscarPorPrefijo(Trie *trie, const char *prefijo, Mapa *grafo){
     printf("\n========== BÚSQUEDA POR PREFIJO: \"%s\" ==========\n", prefijo);
     
-    NodoTrie *actual = trie->raiz;
+    char clave[LARGO_CLAVE_TRIE];
+    NormalizarNombre(prefijo, clave, sizeof(clave));
     
-    // Navegar hasta el final del prefijo
-    for(int i = 0; prefijo[i] != '\0'; i++){
-        int indice = CharAIndice(prefijo[i]);
-        
-        if(indice == -1) continue;
-        
-        if(actual->hijos[indice] == NULL){
-            printf("\nNo se encontraron cepas con el prefijo \"%s\"\n", prefijo);
-            printf("====================================================\n");
-            return;
-        }
-        
-        actual = actual->hijos[indice];
+    // Navegar hasta el final del prefijo (puede terminar a mitad de una arista)
+    int fin_arista;
+    int actual = DescenderTrie(trie, clave, &fin_arista);
+    if(actual < 0){
+        printf("\nNo se encontraron cepas con el prefijo \"%s\"\n", prefijo);
+        printf("====================================================\n");
+        return;
     }
     
     // Recolectar todos los resultados desde este nodo
-    int resultados[50];
+    int *resultados = (int*)malloc((trie->num_palabras + 1) * sizeof(int));
     int num_resultados = 0;
-    char prefijo_actual[100];
-    strcpy(prefijo_actual, prefijo);
-    
-    BuscarPorPrefijoRecursivo(actual, prefijo_actual, strlen(prefijo), 
-                             grafo, resultados, &num_resultados);
+    RecolectarCepasTrie(trie, actual, resultados, &num_resultados, trie->num_palabras);
     
     if(num_resultados == 0){
         printf("\nNo se encontraron cepas.\n");
     } else {
-        printf("\nCepas encontradas: %d\n\n", num_resultados);
+        printf("\nCepas encontradas: %d\n", num_resultados);
+        double prom_contagio, prom_mortalidad;
+        if(EstadisticasPrefijo(trie, prefijo, &prom_contagio, &prom_mortalidad) > 0){
+            printf("Promedio del prefijo: Cont %.3f | Mort %.3f\n", prom_contagio, prom_mortalidad);
+        }
+        printf("\n");
         printf("%-5s %-25s %10s %10s\n", "ID", "Nombre", "Tasa Cont.", "Tasa Mort.");
         printf("----------------------------------------------------------------\n");
         
@@ -2552,6 +7537,163 @@ void BuscarPorPrefijo(Trie *trie, const char *prefijo, Mapa *grafo){
     }
     
     printf("====================================================\n");
+    free(resultados);
+}
+
+//distancia de edicion (levenshtein) directa entre dos claves, para verificar la busqueda en el trie
+int DistanciaEdicion(const char *a, const char *b){
+    int m = (int)strlen(b);
+    int fila[LARGO_CLAVE_TRIE + 1];
+    for(int i = 0; i <= m; i++) fila[i] = i;
+    
+    for(int j = 0; a[j] != '\0'; j++){
+        int diagonal = fila[0];
+        fila[0] = j + 1;
+        for(int i = 1; i <= m; i++){
+            int arriba = fila[i];
+            int d = diagonal + (a[j] == b[i - 1] ? 0 : 1);
+            if(arriba + 1 < d) d = arriba + 1;
+            if(fila[i - 1] + 1 < d) d = fila[i - 1] + 1;
+            fila[i] = d;
+            diagonal = arriba;
+        }
+    }
+    return fila[m];
+}
+
+//baja por el trie calculando una fila de la matriz de levenshtein por byte de etiqueta
+//(equivale a simular el automata de levenshtein de la consulta); si el minimo de la
+//fila supera k ninguna palabra del subarbol puede quedar a distancia <= k y se poda
+//solo se calcula la banda |i - fila| <= k: fuera de ella la distancia ya es mayor que k
+void RecorrerDifusoTrie(Trie *trie, int v, int profundidad, BusquedaDifusa *busqueda){
+    NodoTrie *nodo = &trie->nodos[v];
+    int m = busqueda->m;
+    int k = busqueda->k;
+    
+    for(int j = 0; j < nodo->largo; j++){
+        char c = trie->texto[nodo->etiqueta + j];
+        int *anterior = busqueda->filas[profundidad];
+        int *fila = busqueda->filas[profundidad + 1];
+        profundidad++;
+        
+        int desde = profundidad - k > 1 ? profundidad - k : 1;
+        int hasta = profundidad + k < m ? profundidad + k : m;
+        
+        fila[0] = profundidad <= k ? profundidad : k + 1;
+        int minimo = fila[0];
+        if(desde > 1 && desde - 1 <= m) fila[desde - 1] = k + 1;
+        for(int i = desde; i <= hasta; i++){
+            int d = anterior[i - 1] + (busqueda->clave[i - 1] == c ? 0 : 1);
+            if(anterior[i] + 1 < d) d = anterior[i] + 1;
+            if(fila[i - 1] + 1 < d) d = fila[i - 1] + 1;
+            fila[i] = d;
+            if(d < minimo) minimo = d;
+        }
+        if(hasta < m) fila[hasta + 1] = k + 1;
+        
+        if(minimo > k) return;
+    }
+    busqueda->nodos_visitados++;
+    
+    //la ultima columna solo es valida dentro de la banda
+    int distancia = (profundidad - m <= k && m - profundidad <= k) ? busqueda->filas[profundidad][m] : k + 1;
+    if(nodo->cepa_id >= 0 && distancia <= k){
+        if(busqueda->num_resultados == busqueda->capacidad){
+            busqueda->capacidad *= 2;
+            busqueda->resultados = (CoincidenciaCepa*)realloc(busqueda->resultados,
+                                    busqueda->capacidad * sizeof(CoincidenciaCepa));
+        }
+        CoincidenciaCepa *r = &busqueda->resultados[busqueda->num_resultados];
+        r->cepa_id = nodo->cepa_id;
+        r->distancia = distancia;
+        r->orden = busqueda->num_resultados;
+        busqueda->num_resultados++;
+    }
+    
+    for(int h = nodo->primer_hijo; h >= 0; h = trie->nodos[h].hermano){
+        RecorrerDifusoTrie(trie, h, profundidad, busqueda);
+    }
+}
+
+//ordena por distancia y, a igual distancia, por orden lexicografico del trie
+int CompararCoincidenciaCepa(const void *a, const void *b){
+    const CoincidenciaCepa *x = (const CoincidenciaCepa*)a;
+    const CoincidenciaCepa *y = (const CoincidenciaCepa*)b;
+    if(x->distancia != y->distancia) return x->distancia - y->distancia;
+    return x->orden - y->orden;
+}
+
+//todas las palabras a distancia de edicion <= k de la consulta, ordenadas por distancia
+//retorna la cantidad; *resultados queda en memoria nueva que libera quien llama
+int BuscarAproximadoTrie(Trie *trie, const char *consulta, int k, CoincidenciaCepa **resultados, long *nodos_visitados){
+    BusquedaDifusa busqueda;
+    char clave[LARGO_CLAVE_TRIE];
+    NormalizarNombre(consulta, clave, sizeof(clave));
+    
+    busqueda.clave = clave;
+    busqueda.m = (int)strlen(clave);
+    busqueda.k = k;
+    busqueda.capacidad = 16;
+    busqueda.resultados = (CoincidenciaCepa*)malloc(busqueda.capacidad * sizeof(CoincidenciaCepa));
+    busqueda.num_resultados = 0;
+    busqueda.nodos_visitados = 0;
+    for(int i = 0; i <= busqueda.m; i++){
+        busqueda.filas[0][i] = i;
+    }
+    
+    RecorrerDifusoTrie(trie, 0, 0, &busqueda);
+    qsort(busqueda.resultados, busqueda.num_resultados, sizeof(CoincidenciaCepa), CompararCoincidenciaCepa);
+    
+    if(nodos_visitados != NULL) *nodos_visitados = busqueda.nodos_visitados;
+    *resultados = busqueda.resultados;
+    return busqueda.num_resultados;
+}
+
+//muestra las cepas parecidas a un nombre (tolera errores de escritura)
+void BuscarAproximado(Trie *trie, const char *consulta, int k, Mapa *grafo){
+    printf("\n========== BÚSQUEDA APROXIMADA: \"%s\" (k=%d) ==========\n", consulta, k);
+    
+    CoincidenciaCepa *resultados;
+    long nodos_visitados;
+    double inicio = TiempoActual();
+    int num_resultados = BuscarAproximadoTrie(trie, consulta, k, &resultados, &nodos_visitados);
+    double tiempo = TiempoActual() - inicio;
+    
+    if(num_resultados == 0){
+        printf("\nNo hay cepas a distancia <= %d.\n", k);
+    } else {
+        printf("\nCepas encontradas: %d\n\n", num_resultados);
+        printf("%-5s %-25s %5s %10s %10s\n", "ID", "Nombre", "Dist.", "Tasa Cont.", "Tasa Mort.");
+        printf("----------------------------------------------------------------\n");
+        
+        for(int i = 0; i < num_resultados; i++){
+            int cepa_id = resultados[i].cepa_id;
+            if(cepa_id >= 0 && cepa_id < NUM_CEPAS){
+                Cepa *cepa = &grafo->cepas[cepa_id];
+                printf("%-5d %-25s %5d %10.2f %10.2f\n",
+                       cepa->ID,
+                       cepa->Nombre,
+                       resultados[i].distancia,
+                       cepa->Tasa_contagio,
+                       cepa->Tasa_mortalidad);
+            }
+        }
+    }
+    printf("\nNodos visitados: %ld de %d | Tiempo: %.1f us\n", nodos_visitados, trie->num_nodos, tiempo * 1e6);
+    printf("====================================================\n");
+    
+    free(resultados);
+}
+
+//bytes usados por el trie radix y por un trie de 26 punteros con las mismas palabras
+//(en el de 26 punteros cada byte de etiqueta seria un nodo propio)
+void MemoriaTrie(Trie *trie, long *bytes_radix, long *bytes_clasico){
+    long nodos_clasicos = 1;
+    for(int v = 0; v < trie->num_nodos; v++){
+        nodos_clasicos += trie->nodos[v].largo;
+    }
+    *bytes_radix = (long)trie->num_nodos * sizeof(NodoTrie) + trie->largo_texto;
+    *bytes_clasico = nodos_clasicos * (26 * sizeof(void*) + 2 * sizeof(int));
 }
 
 //inicializa el trie con todas las cepas del sistema
@@ -2560,8 +7702,7 @@ void InicializarTrie(Mapa *grafo){
     
     if(grafo->trie_cepas != NULL){
         printf("Liberando Trie anterior...\n");
-        LiberarTrie(grafo->trie_cepas->raiz);
-        free(grafo->trie_cepas);
+        LiberarTrie(grafo->trie_cepas);
     }
     
     grafo->trie_cepas = CrearTrie();
@@ -2570,83 +7711,287 @@ void InicializarTrie(Mapa *grafo){
     for(int i = 0; i < NUM_CEPAS; i++){
         InsertarEnTrie(grafo->trie_cepas, grafo->cepas[i].Nombre, i);
     }
+    CalcularAgregadosTrie(grafo->trie_cepas, grafo->cepas, NUM_CEPAS);
     
+    long bytes_radix, bytes_clasico;
+    MemoriaTrie(grafo->trie_cepas, &bytes_radix, &bytes_clasico);
     printf("✓ Trie inicializado con %d cepas\n", grafo->trie_cepas->num_palabras);
+    printf("  Nodos: %d | Memoria: %ld bytes (trie de 26 punteros: %ld bytes, %.1fx)\n",
+           grafo->trie_cepas->num_nodos, bytes_radix, bytes_clasico, (double)bytes_clasico / bytes_radix);
 }
 
-void MostrarCepasPorCluster(Mapa *grafo){
-    printf("\n========== CLUSTERING DE CEPAS ==========\n");
+//registro sintetico de linajes estilo pango (ej. B.1.1.529, XBB.1.5.70)
+//verifica que cada nombre se recupere exacto y mide memoria y tiempo de consulta
+void PruebaTrieVariantes(int num_variantes){
+    printf("\n========== TRIE RADIX: REGISTRO DE VARIANTES ==========\n");
     
-    // Agrupar cepas por prefijo
-    const char *prefijos[] = {"Alpha", "Beta", "Gamma", "Delta", "Epsilon", 
-                              "Zeta", "Eta", "Theta", "Iota", "Kappa"};
-    int num_prefijos = 10;
+    if(num_variantes <= 0){
+        printf("Cantidad invalida.\n");
+        return;
+    }
     
-    for(int p = 0; p < num_prefijos; p++){
-        printf("\n--- Cluster: %s ---\n", prefijos[p]);
+    const char *raices[] = {"B", "BA", "BQ", "XBB", "JN", "KP", "EG", "AY", "P", "C", "XEC", "LP"};
+    int num_raices = 12;
+    int largo = 24;
+    char *nombres = (char*)malloc((long)num_variantes * largo);
+    Trie *trie = CrearTrie();
+    unsigned long long estado = 0x2545F4914F6CDD1DULL;
+    
+    double inicio = TiempoActual();
+    int generados = 0;
+    int intentos = 0;
+    while(generados < num_variantes && intentos < num_variantes * 20){
+        intentos++;
+        char *nombre = nombres + (long)generados * largo;
+        int escrito = snprintf(nombre, largo, "%s", raices[SiguienteXorshift(&estado) % num_raices]);
+        int componentes = 1 + (int)(SiguienteXorshift(&estado) % 4);
+        for(int c = 0; c < componentes && escrito < largo - 5; c++){
+            escrito += snprintf(nombre + escrito, largo - escrito, ".%d", (int)(SiguienteXorshift(&estado) % 600));
+        }
+        if(BuscarEnTrie(trie, nombre) >= 0) continue;
+        InsertarEnTrie(trie, nombre, generados);
+        generados++;
+    }
+    double t_construccion = TiempoActual() - inicio;
+    
+    //consultas exactas de todos los nombres y de nombres recortados un byte (casi siempre ausentes)
+    int errores = 0;
+    inicio = TiempoActual();
+    for(int i = 0; i < generados; i++){
+        if(BuscarEnTrie(trie, nombres + (long)i * largo) != i) errores++;
+    }
+    double t_consultas = TiempoActual() - inicio;
+    
+    char recortado[24];
+    for(int i = 0; i < generados; i++){
+        strcpy(recortado, nombres + (long)i * largo);
+        recortado[strlen(recortado) - 1] = '\0';
+        int id = BuscarEnTrie(trie, recortado);
+        if(id >= 0 && strcmp(nombres + (long)id * largo, recortado) != 0) errores++;
+    }
+    
+    //busqueda aproximada con un error de escritura, comparada contra la distancia directa
+    int num_difusas = generados < 200 ? generados : 200;
+    double t_difusa[3] = {0.0, 0.0, 0.0};
+    long visitados_difusa[3] = {0, 0, 0};
+    char consulta[24];
+    char normalizado[24];
+    for(int q = 0; q < num_difusas; q++){
+        NormalizarNombre(nombres + (long)(SiguienteXorshift(&estado) % generados) * largo, consulta, sizeof(consulta));
+        int pos = (int)(SiguienteXorshift(&estado) % strlen(consulta));
+        consulta[pos] = (consulta[pos] == '1') ? '7' : '1';
         
-        int count = 0;
-        for(int i = 0; i < NUM_CEPAS; i++){
-            // Verificar si el nombre empieza con este prefijo
-            if(strncmp(grafo->cepas[i].Nombre, prefijos[p], strlen(prefijos[p])) == 0){
-                printf("  %d. %s (Cont: %.2f, Mort: %.2f)\n",
-                       count + 1,
-                       grafo->cepas[i].Nombre,
-                       grafo->cepas[i].Tasa_contagio,
-                       grafo->cepas[i].Tasa_mortalidad);
-                count++;
+        for(int k = 1; k <= 2; k++){
+            CoincidenciaCepa *resultados;
+            long visitados;
+            inicio = TiempoActual();
+            int encontrados = BuscarAproximadoTrie(trie, consulta, k, &resultados, &visitados);
+            t_difusa[k] += TiempoActual() - inicio;
+            visitados_difusa[k] += visitados;
+            
+            int esperados = 0;
+            for(int i = 0; i < generados; i++){
+                NormalizarNombre(nombres + (long)i * largo, normalizado, sizeof(normalizado));
+                if(DistanciaEdicion(normalizado, consulta) <= k) esperados++;
+            }
+            if(encontrados != esperados) errores++;
+            for(int r = 0; r < encontrados; r++){
+                NormalizarNombre(nombres + (long)resultados[r].cepa_id * largo, normalizado, sizeof(normalizado));
+                if(DistanciaEdicion(normalizado, consulta) != resultados[r].distancia) errores++;
+                if(r > 0 && resultados[r].distancia < resultados[r - 1].distancia) errores++;
             }
+            free(resultados);
         }
-        
-        if(count == 0){
-            printf("  (Ninguna cepa en este cluster)\n");
-        } else {
-            printf("  Total: %d cepas\n", count);
+    }
+    
+    long bytes_radix, bytes_clasico;
+    MemoriaTrie(trie, &bytes_radix, &bytes_clasico);
+    
+    printf("Variantes: %d (ej. %s, %s)\n", generados, nombres, generados > 1 ? nombres + largo : "");
+    printf("Nodos radix: %d (%d bytes c/u)\n", trie->num_nodos, (int)sizeof(NodoTrie));
+    printf("Memoria radix: %.1f KB | trie de 26 punteros: %.1f KB (%.1fx menos)\n",
+           bytes_radix / 1024.0, bytes_clasico / 1024.0, (double)bytes_clasico / bytes_radix);
+    printf("Construccion: %.2f ms | Consulta exacta: %.1f ns promedio\n",
+           t_construccion * 1000.0, t_consultas * 1e9 / generados);
+    if(num_difusas > 0){
+        for(int k = 1; k <= 2; k++){
+            printf("Aproximada k=%d: %.1f us promedio | %ld nodos visitados de %d\n",
+                   k, t_difusa[k] * 1e6 / num_difusas, visitados_difusa[k] / num_difusas, trie->num_nodos);
         }
     }
+    printf("Errores de recuperacion: %d\n", errores);
+    printf("=======================================================\n");
     
-    printf("\n=========================================\n");
+    LiberarTrie(trie);
+    free(nombres);
+}
+
+//separadores de segmentos en nombres de cepa ("alpha-flu-3", "b.1.1.529")
+int EsSeparadorCepa(char c){
+    return c == '-' || c == '.' || c == '_' || c == ' ';
+}
+
+//acumula en postorden cantidad de cepas y sumas de tasas del subarbol de v
+void AcumularSubarbolTrie(Trie *trie, int v, Cepa *cepas, int num_cepas){
+    int cantidad = 0;
+    double suma_contagio = 0.0;
+    double suma_mortalidad = 0.0;
     
-    // Estadísticas por cluster
-    printf("\n--- ESTADÍSTICAS POR CLUSTER ---\n");
-    printf("%-15s %8s %12s %12s\n", "Cluster", "Cantidad", "Avg Cont.", "Avg Mort.");
-    printf("-----------------------------------------------------\n");
+    int id = trie->nodos[v].cepa_id;
+    if(id >= 0 && id < num_cepas){
+        cantidad = 1;
+        suma_contagio = cepas[id].Tasa_contagio;
+        suma_mortalidad = cepas[id].Tasa_mortalidad;
+    }
     
-    for(int p = 0; p < num_prefijos; p++){
-        int count = 0;
-        float suma_cont = 0.0;
-        float suma_mort = 0.0;
-        
-        for(int i = 0; i < NUM_CEPAS; i++){
-            if(strncmp(grafo->cepas[i].Nombre, prefijos[p], strlen(prefijos[p])) == 0){
-                count++;
-                suma_cont += grafo->cepas[i].Tasa_contagio;
-                suma_mort += grafo->cepas[i].Tasa_mortalidad;
-            }
+    for(int h = trie->nodos[v].primer_hijo; h >= 0; h = trie->nodos[h].hermano){
+        AcumularSubarbolTrie(trie, h, cepas, num_cepas);
+        cantidad += trie->cantidad_subarbol[h];
+        suma_contagio += trie->suma_contagio[h];
+        suma_mortalidad += trie->suma_mortalidad[h];
+    }
+    
+    trie->cantidad_subarbol[v] = cantidad;
+    trie->suma_contagio[v] = suma_contagio;
+    trie->suma_mortalidad[v] = suma_mortalidad;
+}
+
+//calcula los agregados de todos los nodos en un solo recorrido
+void CalcularAgregadosTrie(Trie *trie, Cepa *cepas, int num_cepas){
+    free(trie->cantidad_subarbol);
+    free(trie->suma_contagio);
+    free(trie->suma_mortalidad);
+    trie->cantidad_subarbol = (int*)malloc(trie->num_nodos * sizeof(int));
+    trie->suma_contagio = (double*)malloc(trie->num_nodos * sizeof(double));
+    trie->suma_mortalidad = (double*)malloc(trie->num_nodos * sizeof(double));
+    
+    AcumularSubarbolTrie(trie, 0, cepas, num_cepas);
+    trie->agregados_listos = 1;
+}
+
+//estadisticas de las cepas que empiezan con un prefijo en o(|prefijo|)
+//retorna la cantidad de cepas (0 si no hay o si faltan los agregados)
+int EstadisticasPrefijo(Trie *trie, const char *prefijo, double *prom_contagio, double *prom_mortalidad){
+    *prom_contagio = 0.0;
+    *prom_mortalidad = 0.0;
+    if(!trie->agregados_listos) return 0;
+    
+    char clave[LARGO_CLAVE_TRIE];
+    NormalizarNombre(prefijo, clave, sizeof(clave));
+    
+    int fin_arista;
+    int v = DescenderTrie(trie, clave, &fin_arista);
+    if(v < 0 || trie->cantidad_subarbol[v] == 0) return 0;
+    
+    int cantidad = trie->cantidad_subarbol[v];
+    *prom_contagio = trie->suma_contagio[v] / cantidad;
+    *prom_mortalidad = trie->suma_mortalidad[v] / cantidad;
+    return cantidad;
+}
+
+//primera cepa del subarbol en orden lexicografico (su nombre da el prefijo con mayusculas originales)
+int CepaRepresentanteTrie(Trie *trie, int v){
+    while(trie->nodos[v].cepa_id < 0 && trie->nodos[v].primer_hijo >= 0){
+        v = trie->nodos[v].primer_hijo;
+    }
+    return trie->nodos[v].cepa_id;
+}
+
+//recorre el trie en preorden: un cluster es un prefijo que termina en separador
+//y agrupa al menos MIN_CEPAS_CLUSTER cepas; los clusters anidados forman la jerarquia
+void RecorrerClustersTrie(Trie *trie, int v, int profundidad, int nivel, Mapa *grafo,
+                          ClusterCepas *clusters, int *num_clusters){
+    NodoTrie *nodo = &trie->nodos[v];
+    
+    //varios separadores en una misma etiqueta agrupan el mismo subarbol: se usa el ultimo
+    int corte = -1;
+    for(int j = nodo->largo - 1; j >= 0; j--){
+        if(EsSeparadorCepa(trie->texto[nodo->etiqueta + j])){
+            corte = profundidad + j + 1;
+            break;
         }
+    }
+    
+    if(corte > 0 && trie->cantidad_subarbol[v] >= MIN_CEPAS_CLUSTER){
+        int representante = CepaRepresentanteTrie(trie, v);
+        ClusterCepas *cluster = &clusters[(*num_clusters)++];
+        cluster->nodo = v;
+        cluster->representante = representante;
+        cluster->largo_prefijo = corte;
+        cluster->nivel = nivel;
         
-        if(count > 0){
-            printf("%-15s %8d %12.3f %12.3f\n", 
-                   prefijos[p], 
-                   count,
-                   suma_cont / count,
-                   suma_mort / count);
-        }
+        printf("\n%*s--- Cluster: %.*s* (%d cepas) ---\n", 2 * nivel, "",
+               corte, grafo->cepas[representante].Nombre, trie->cantidad_subarbol[v]);
+        nivel++;
     }
     
-    printf("=====================================================\n");
+    int id = nodo->cepa_id;
+    if(id >= 0 && id < NUM_CEPAS){
+        printf("%*s  %s (Cont: %.2f, Mort: %.2f)\n", 2 * nivel, "",
+               grafo->cepas[id].Nombre,
+               grafo->cepas[id].Tasa_contagio,
+               grafo->cepas[id].Tasa_mortalidad);
+    }
+    
+    for(int h = nodo->primer_hijo; h >= 0; h = trie->nodos[h].hermano){
+        RecorrerClustersTrie(trie, h, profundidad + nodo->largo, nivel, grafo, clusters, num_clusters);
+    }
 }
 
-void LiberarTrie(NodoTrie *nodo){
-    if(nodo == NULL) return;
+void MostrarCepasPorCluster(Mapa *grafo){
+    if(grafo->trie_cepas == NULL){
+        InicializarTrie(grafo);
+    }
+    Trie *trie = grafo->trie_cepas;
+    if(!trie->agregados_listos){
+        CalcularAgregadosTrie(trie, grafo->cepas, NUM_CEPAS);
+    }
     
-    for(int i = 0; i < ALPHABET_SIZE; i++){
-        if(nodo->hijos[i] != NULL){
-            LiberarTrie(nodo->hijos[i]);
-        }
+    printf("\n========== CLUSTERING DE CEPAS ==========\n");
+    
+    // Jerarquia derivada de los prefijos compartidos en el trie
+    ClusterCepas *clusters = (ClusterCepas*)malloc(trie->num_nodos * sizeof(ClusterCepas));
+    int num_clusters = 0;
+    RecorrerClustersTrie(trie, 0, 0, 0, grafo, clusters, &num_clusters);
+    
+    if(num_clusters == 0){
+        printf("\n(Ninguna cepa comparte prefijo con otra)\n");
     }
     
-    free(nodo);
+    printf("\n=========================================\n");
+    
+    // Estadísticas por cluster (leidas de los agregados del nodo)
+    printf("\n--- ESTADÍSTICAS POR CLUSTER ---\n");
+    printf("%-28s %8s %12s %12s\n", "Cluster", "Cantidad", "Avg Cont.", "Avg Mort.");
+    printf("-----------------------------------------------------------------\n");
+    
+    for(int c = 0; c < num_clusters; c++){
+        ClusterCepas *cluster = &clusters[c];
+        int cantidad = trie->cantidad_subarbol[cluster->nodo];
+        char etiqueta[LARGO_CLAVE_TRIE + 32];
+        snprintf(etiqueta, sizeof(etiqueta), "%*s%.*s*", 2 * cluster->nivel, "",
+                 cluster->largo_prefijo, grafo->cepas[cluster->representante].Nombre);
+        
+        printf("%-28s %8d %12.3f %12.3f\n",
+               etiqueta,
+               cantidad,
+               trie->suma_contagio[cluster->nodo] / cantidad,
+               trie->suma_mortalidad[cluster->nodo] / cantidad);
+    }
+    
+    printf("=================================================================\n");
+    free(clusters);
+}
+
+//libera el arreglo de nodos, el texto de etiquetas y el trie
+void LiberarTrie(Trie *trie){
+    if(trie == NULL) return;
+    free(trie->nodos);
+    free(trie->texto);
+    free(trie->cantidad_subarbol);
+    free(trie->suma_contagio);
+    free(trie->suma_mortalidad);
+    free(trie);
 }
 
 //=============================================================
@@ -2687,7 +8032,7 @@ void QuickSort(IndividuoOrden *arr, int inicio, int fin){
 //ordena individuos por riesgo descendente usando quicksort
 void OrdenarPorRiesgoQuick(Mapa *grafo){
     printf("\n========== QUICKSORT POR RIESGO ==========\n");
-    printf("Complejidad: O(n log n) promedio, O(n²) peor caso\n\n");
+    printf("Complejidad: O(n + k log k) promedio con seleccion top-k\n\n");
     
     int total = 0;
     for(int t = 0; t < NUM_TERRITORIOS; t++){
@@ -2713,8 +8058,8 @@ void OrdenarPorRiesgoQuick(Mapa *grafo){
         }
     }
     
-    printf("Ordenando %d individuos con QuickSort...\n", idx);
-    QuickSort(lista, 0, idx - 1);
+    printf("Seleccionando top 15 de %d individuos (QuickSelect + QuickSort)...\n", idx);
+    SeleccionarTopK(lista, idx, 15);
     
     printf("\n--- Top 15 MAYOR RIESGO ---\n");
     for(int i = 0; i < 15 && i < idx; i++){
@@ -2764,6 +8109,179 @@ void QuickSortRiesgo(IndividuoRiesgo *arr, int inicio, int fin){
     }
 }
 
+//=============================================================
+//seleccion top-k con quickselect - o(n) promedio
+//=============================================================
+
+//particion en tres vias (descendente): [mayores | iguales | menores]
+//el bloque igual al pivote queda en arr[*lt..*gt], util con muchos empates
+void ParticionarTresViasRiesgo(IndividuoRiesgo *arr, int inicio, int fin, int *lt, int *gt){
+    //pivote por mediana de tres para evitar el peor caso con datos ordenados
+    float a = arr[inicio].riesgo_calculado;
+    float b = arr[inicio + (fin - inicio) / 2].riesgo_calculado;
+    float c = arr[fin].riesgo_calculado;
+    float pivote = (a < b) ? ((b < c) ? b : ((a < c) ? c : a))
+                           : ((a < c) ? a : ((b < c) ? c : b));
+    
+    int i = inicio;
+    *lt = inicio;
+    *gt = fin;
+    
+    while(i <= *gt){
+        if(arr[i].riesgo_calculado > pivote){
+            IndividuoRiesgo temp = arr[*lt];
+            arr[*lt] = arr[i];
+            arr[i] = temp;
+            (*lt)++;
+            i++;
+        } else if(arr[i].riesgo_calculado < pivote){
+            IndividuoRiesgo temp = arr[*gt];
+            arr[*gt] = arr[i];
+            arr[i] = temp;
+            (*gt)--;
+        } else {
+            i++;
+        }
+    }
+}
+
+//coloca en arr[pos] el elemento que le corresponde en orden descendente
+//todo lo anterior a pos queda mayor o igual (sin ordenar)
+void QuickSelectRiesgo(IndividuoRiesgo *arr, int inicio, int fin, int pos){
+    while(inicio < fin){
+        int lt, gt;
+        ParticionarTresViasRiesgo(arr, inicio, fin, &lt, &gt);
+        
+        if(pos < lt) fin = lt - 1;
+        else if(pos > gt) inicio = gt + 1;
+        else return;
+    }
+}
+
+//deja los k de mayor riesgo en arr[0..k-1] y los ordena - o(n + k log k)
+//con openmp cada hilo reduce su bloque a k candidatos antes de la seleccion final
+void SeleccionarTopKRiesgo(IndividuoRiesgo *arr, int n, int k){
+    if(n <= 0 || k <= 0) return;
+    if(k > n) k = n;
+    
+#ifdef _OPENMP
+    int hilos = omp_get_max_threads();
+    if(n >= UMBRAL_TOPK_PARALELO && hilos > 1 && (long)k * hilos * 4 < n){
+        int bloque = (n + hilos - 1) / hilos;
+        
+        #pragma omp parallel for schedule(static)
+        for(int h = 0; h < hilos; h++){
+            int ini = h * bloque;
+            int fin = (ini + bloque < n) ? ini + bloque - 1 : n - 1;
+            if(fin - ini + 1 > k){
+                QuickSelectRiesgo(arr, ini, fin, ini + k - 1);
+            }
+        }
+        
+        //compactar los candidatos de cada bloque al inicio del arreglo
+        int m = 0;
+        for(int h = 0; h < hilos && h * bloque < n; h++){
+            int ini = h * bloque;
+            int tam = (n - ini < k) ? n - ini : k;
+            for(int j = 0; j < tam; j++){
+                IndividuoRiesgo temp = arr[m];
+                arr[m] = arr[ini + j];
+                arr[ini + j] = temp;
+                m++;
+            }
+        }
+        n = m;
+    }
+#endif
+    
+    if(k < n){
+        QuickSelectRiesgo(arr, 0, n - 1, k - 1);
+    }
+    QuickSortRiesgo(arr, 0, k - 1);
+}
+
+//particion en tres vias (descendente) para IndividuoOrden
+void ParticionarTresVias(IndividuoOrden *arr, int inicio, int fin, int *lt, int *gt){
+    float a = arr[inicio].valor_orden;
+    float b = arr[inicio + (fin - inicio) / 2].valor_orden;
+    float c = arr[fin].valor_orden;
+    float pivote = (a < b) ? ((b < c) ? b : ((a < c) ? c : a))
+                           : ((a < c) ? a : ((b < c) ? c : b));
+    
+    int i = inicio;
+    *lt = inicio;
+    *gt = fin;
+    
+    while(i <= *gt){
+        if(arr[i].valor_orden > pivote){
+            IndividuoOrden temp = arr[*lt];
+            arr[*lt] = arr[i];
+            arr[i] = temp;
+            (*lt)++;
+            i++;
+        } else if(arr[i].valor_orden < pivote){
+            IndividuoOrden temp = arr[*gt];
+            arr[*gt] = arr[i];
+            arr[i] = temp;
+            (*gt)--;
+        } else {
+            i++;
+        }
+    }
+}
+
+//quickselect descendente para IndividuoOrden
+void QuickSelect(IndividuoOrden *arr, int inicio, int fin, int pos){
+    while(inicio < fin){
+        int lt, gt;
+        ParticionarTresVias(arr, inicio, fin, &lt, &gt);
+        
+        if(pos < lt) fin = lt - 1;
+        else if(pos > gt) inicio = gt + 1;
+        else return;
+    }
+}
+
+//deja los k mayores por valor_orden en arr[0..k-1] ordenados - o(n + k log k)
+void SeleccionarTopK(IndividuoOrden *arr, int n, int k){
+    if(n <= 0 || k <= 0) return;
+    if(k > n) k = n;
+    
+#ifdef _OPENMP
+    int hilos = omp_get_max_threads();
+    if(n >= UMBRAL_TOPK_PARALELO && hilos > 1 && (long)k * hilos * 4 < n){
+        int bloque = (n + hilos - 1) / hilos;
+        
+        #pragma omp parallel for schedule(static)
+        for(int h = 0; h < hilos; h++){
+            int ini = h * bloque;
+            int fin = (ini + bloque < n) ? ini + bloque - 1 : n - 1;
+            if(fin - ini + 1 > k){
+                QuickSelect(arr, ini, fin, ini + k - 1);
+            }
+        }
+        
+        int m = 0;
+        for(int h = 0; h < hilos && h * bloque < n; h++){
+            int ini = h * bloque;
+            int tam = (n - ini < k) ? n - ini : k;
+            for(int j = 0; j < tam; j++){
+                IndividuoOrden temp = arr[m];
+                arr[m] = arr[ini + j];
+                arr[ini + j] = temp;
+                m++;
+            }
+        }
+        n = m;
+    }
+#endif
+    
+    if(k < n){
+        QuickSelect(arr, 0, n - 1, k - 1);
+    }
+    QuickSort(arr, 0, k - 1);
+}
+
 //=============================================================
 //quicksort por grado (descendente)
 //=============================================================
@@ -3239,22 +8757,15 @@ void OrdenarPorGrado(Mapa *grafo){
         Territorio *territorio = &grafo->territorios[t];
         for(int i = 0; i < territorio->num_individuos; i++){
             if(territorio->individuos[i] != NULL){
-                int num_contactos = 0;
-                Contacto *c = territorio->individuos[i]->contactos;
-                while(c != NULL){
-                    num_contactos++;
-                    c = c->sgt;
-                }
-                
                 lista[idx].individuo = territorio->individuos[i];
-                lista[idx].valor_orden = num_contactos;
+                lista[idx].valor_orden = territorio->individuos[i]->Grado;
                 idx++;
             }
         }
     }
     
-    //ordenar por grado usando quicksort propio
-    QuickSortGrado(lista, 0, idx - 1);
+    //seleccionar los 15 de mayor grado sin ordenar toda la poblacion
+    SeleccionarTopK(lista, idx, 15);
     
     printf("\n--- Top 15 MÁS CONTACTOS ---\n");
     for(int i = 0; i < 15 && i < idx; i++){
@@ -3353,7 +8864,7 @@ void AnalisisDatos(Mapa *grafo){
             if(ind != NULL){
                 total_individuos++;
                 suma_riesgo += ind->Riesgo_inicial;
-                suma_grado += ind->Grado_inicial;
+                suma_grado += ind->Grado;
                 
                 if(ind->Infectado) total_infectados++;
                 if(ind->Recuperado) total_recuperados++;
@@ -3376,7 +8887,8 @@ void AnalisisDatos(Mapa *grafo){
     for(int t = 0; t < NUM_TERRITORIOS; t++){
         Territorio *territorio = &grafo->territorios[t];
         if(territorio->num_individuos > 0){
-            printf("%s: %d individuos\n", territorio->Nombre, territorio->num_individuos);
+            printf("%s: %d individuos, riesgo %.2f\n", territorio->Nombre,
+                   territorio->num_individuos, CalcularRiesgoTerritorio(grafo, t));
         }
     }
     
@@ -3415,16 +8927,13 @@ void InicializarSemillas(Mapa *grafo){
 void AplicarSemillas(Mapa *grafo){
     for(int i = 0; i < grafo->num_semillas; i++){
         // Buscar el individuo por ID
-        for(int t = 0; t < NUM_TERRITORIOS; t++){
-            Territorio *terr = &grafo->territorios[t];
-            for(int j = 0; j < terr->num_individuos; j++){
-                if(terr->individuos[j] != NULL && 
-                   terr->individuos[j]->ID == grafo->semillas[i].individuo_id){
-                    terr->individuos[j]->Infectado = 1;
-                    terr->individuos[j]->t_infeccion = grafo->semillas[i].t0;
-                    terr->individuos[j]->Cepa_ID = grafo->semillas[i].cepa_id;
-                }
-            }
+        Individuo *ind = IndividuoPorID(grafo, grafo->semillas[i].individuo_id);
+        if(ind != NULL){
+            float riesgo_antes = RiesgoIndividuo(ind);
+            MarcarInfectado(grafo, ind, 1);
+            ind->t_infeccion = grafo->semillas[i].t0;
+            ind->Cepa_ID = grafo->semillas[i].cepa_id;
+            ActualizarRiesgo(grafo, ind, riesgo_antes);
         }
     }
 }
@@ -3442,18 +8951,14 @@ void MostrarSemillas(Mapa *grafo){
         int ind_id = grafo->semillas[i].individuo_id;
         
         // Buscar información del individuo
-        for(int t = 0; t < NUM_TERRITORIOS; t++){
-            Territorio *terr = &grafo->territorios[t];
-            for(int j = 0; j < terr->num_individuos; j++){
-                if(terr->individuos[j] != NULL && terr->individuos[j]->ID == ind_id){
-                    printf("%-5d %-20s %-15s %-20s %-5d\n",
-                           i + 1,
-                           terr->individuos[j]->Nombre,
-                           terr->Nombre,
-                           grafo->cepas[grafo->semillas[i].cepa_id].Nombre,
-                           grafo->semillas[i].t0);
-                }
-            }
+        Individuo *ind = IndividuoPorID(grafo, ind_id);
+        if(ind != NULL){
+            printf("%-5d %-20s %-15s %-20s %-5d\n",
+                   i + 1,
+                   ind->Nombre,
+                   grafo->territorios[ind->Territorio_ID].Nombre,
+                   grafo->cepas[grafo->semillas[i].cepa_id].Nombre,
+                   grafo->semillas[i].t0);
         }
     }
     